@@ -2,64 +2,311 @@
 #define BLOOM_FILTER_HPP
 
 #include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <span>
 #include <string>
+#include <string_view>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
 #include <stdexcept>
+#include <exception>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BLOOM_FILTER_X86_AVAILABLE 1
+#define BLOOM_FILTER_AVX2_TARGET __attribute__((target("avx2")))
+#define BLOOM_FILTER_AVX512_TARGET __attribute__((target("avx512f")))
+#endif
+
 namespace CryptoTools
 {
 
-    // 布隆过滤器类模板，支持任意类型元素
-    template <typename T>
+    /**
+     * @brief 已知均匀随机的16字节键（如PRF_AES::Output形式的OPRF/PRF输出）
+     * 以该类型作为布隆过滤器的元素时跳过哈希计算，直接使用键的两个64位半部分；
+     * 普通的std::array<uint8_t, 16>（UUID、IPv6地址、计数器等）仍按MurmurHash3哈希
+     */
+    struct UniformKey128
+    {
+        std::array<uint8_t, 16> bytes;
+    };
+
+    // 布隆过滤器使用的键哈希
+    namespace BloomHash
+    {
+        // 128位哈希值，两半作为双重哈希的h1与h2
+        struct Hash128
+        {
+            uint64_t low;
+            uint64_t high;
+        };
+
+        inline uint64_t rotl(uint64_t x, int r)
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        /**
+         * @brief 64位混合函数（splitmix64的输出变换），由一个哈希值派生出相互独立的新哈希值
+         */
+        inline uint64_t mix(uint64_t x)
+        {
+            x += 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        // MurmurHash3的64位终结函数
+        inline uint64_t fmix(uint64_t k)
+        {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdULL;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ULL;
+            k ^= k >> 33;
+            return k;
+        }
+
+        /**
+         * @brief 对字节串计算128位哈希（MurmurHash3_x64_128，每次处理16字节，只扫描一遍输入）
+         */
+        inline Hash128 hash_bytes(const void *data, size_t length, uint64_t seed = 0x9E3779B97F4A7C15ULL)
+        {
+            const uint64_t c1 = 0x87c37b91114253d5ULL;
+            const uint64_t c2 = 0x4cf5ad432745937fULL;
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            uint64_t h1 = seed;
+            uint64_t h2 = seed;
+
+            size_t blocks = length / 16;
+            for (size_t i = 0; i < blocks; ++i)
+            {
+                uint64_t k1, k2;
+                std::memcpy(&k1, bytes + 16 * i, 8);
+                std::memcpy(&k2, bytes + 16 * i + 8, 8);
+
+                k1 *= c1;
+                k1 = rotl(k1, 31);
+                k1 *= c2;
+                h1 ^= k1;
+                h1 = rotl(h1, 27);
+                h1 += h2;
+                h1 = h1 * 5 + 0x52dce729;
+
+                k2 *= c2;
+                k2 = rotl(k2, 33);
+                k2 *= c1;
+                h2 ^= k2;
+                h2 = rotl(h2, 31);
+                h2 += h1;
+                h2 = h2 * 5 + 0x38495ab5;
+            }
+
+            // 尾部不足16字节的部分按小端序拼成两个64位字
+            const unsigned char *tail = bytes + 16 * blocks;
+            size_t rest = length & 15;
+            uint64_t k1 = 0;
+            uint64_t k2 = 0;
+            for (size_t i = rest; i > 8; --i)
+            {
+                k2 = (k2 << 8) | tail[i - 1];
+            }
+            for (size_t i = std::min<size_t>(rest, 8); i > 0; --i)
+            {
+                k1 = (k1 << 8) | tail[i - 1];
+            }
+            if (rest > 8)
+            {
+                k2 *= c2;
+                k2 = rotl(k2, 33);
+                k2 *= c1;
+                h2 ^= k2;
+            }
+            if (rest > 0)
+            {
+                k1 *= c1;
+                k1 = rotl(k1, 31);
+                k1 *= c2;
+                h1 ^= k1;
+            }
+
+            h1 ^= length;
+            h2 ^= length;
+            h1 += h2;
+            h2 += h1;
+            h1 = fmix(h1);
+            h2 = fmix(h2);
+            h1 += h2;
+            h2 += h1;
+            return {h1, h2};
+        }
+
+        /**
+         * @brief 元素的128位哈希
+         * 字符串类按字符内容哈希；浮点数先把-0.0归一为0.0；整数、定长字节数组等没有填充位的类型按对象表示哈希。
+         * 需要自定义哈希的类型可以特化该模板
+         */
+        template <typename T>
+        struct KeyHash
+        {
+            Hash128 operator()(const T &item) const
+            {
+                if constexpr (std::is_convertible_v<const T &, std::string_view>)
+                {
+                    std::string_view view(item);
+                    return hash_bytes(view.data(), view.size());
+                }
+                else if constexpr (std::is_floating_point_v<T>)
+                {
+                    T value = item == T(0) ? T(0) : item;
+                    return hash_bytes(&value, sizeof(T));
+                }
+                else
+                {
+                    static_assert(std::has_unique_object_representations_v<T>,
+                                  "BloomHash只支持字符串、浮点数或没有填充位的定长类型");
+                    return hash_bytes(&item, sizeof(T));
+                }
+            }
+        };
+
+        /**
+         * @brief 均匀随机16字节键（UniformKey128）的特化
+         * 这类键本身就是伪随机的，直接把两个64位半部分作为哈希值，完全跳过哈希计算。
+         * 只有显式包装为UniformKey128的键走这条路径，避免结构化的16字节数据被误用
+         */
+        template <>
+        struct KeyHash<UniformKey128>
+        {
+            Hash128 operator()(const UniformKey128 &item) const
+            {
+                Hash128 hash;
+                std::memcpy(&hash.low, item.bytes.data(), 8);
+                std::memcpy(&hash.high, item.bytes.data() + 8, 8);
+                return hash;
+            }
+        };
+
+        template <typename T>
+        Hash128 hash(const T &item)
+        {
+            return KeyHash<T>{}(item);
+        }
+
+        /**
+         * @brief 将64位哈希值均匀映射到[0, range)，用乘法代替取模
+         */
+        inline uint64_t reduce(uint64_t hash, uint64_t range)
+        {
+            return static_cast<uint64_t>((static_cast<unsigned __int128>(hash) * range) >> 64);
+        }
+    }
+
+    /**
+     * @brief 布隆过滤器类模板，支持任意类型元素
+     * @tparam T 元素类型
+     * @tparam Concurrent 为false时是普通的单线程布隆过滤器；为true时位数组由std::atomic<uint64_t>组成，
+     *         插入用fetch_or置位，多个线程可以同时insert/contains，并可用insert_parallel多线程构建
+     */
+    template <typename T, bool Concurrent = false>
     class BloomFilter
     {
+    public:
+        // 批量接口每个窗口处理的元素数量：窗口内的探测位置先全部预取再访问
+        static constexpr size_t BATCH_WINDOW = 32;
+        // 并行构建时每个线程每次领取的元素数量
+        static constexpr size_t PARALLEL_CHUNK = 16384;
+
     private:
-        std::vector<bool> bit_array; // 位数组，存储元素存在标记
+        using Word = std::conditional_t<Concurrent, std::atomic<uint64_t>, uint64_t>;
+        using Counter = std::conditional_t<Concurrent, std::atomic<size_t>, size_t>;
+
+        std::vector<Word> bit_words; // 位数组，按64位字存储元素存在标记
         size_t bit_size;             // 位数组大小（位）
         size_t hash_count;           // 哈希函数数量
-        size_t item_count;           // 已插入元素数量
+        Counter item_count;          // 已插入元素数量
 
-        // 哈希函数1：基于DJB2算法
-        uint64_t hash1(const T &item) const
+        /**
+         * @brief 第i个探测位置（Kirsch–Mitzenmacher双重哈希）
+         * g_i = h1 + i * h2，k个位置都由元素的同一个128位哈希值派生，元素本身只哈希一次
+         */
+        size_t probe(const BloomHash::Hash128 &hash, size_t i) const
         {
-            std::string str = std::to_string(item); // 对于非字符串类型转换为字符串
-            uint64_t hash = 5381;
-            for (char c : str)
+            return static_cast<size_t>(BloomHash::reduce(hash.low + i * hash.high, bit_size));
+        }
+
+        bool test_bit(size_t position) const
+        {
+            uint64_t word;
+            if constexpr (Concurrent)
+            {
+                word = bit_words[position >> 6].load(std::memory_order_relaxed);
+            }
+            else
             {
-                hash = ((hash << 5) + hash) + static_cast<uint64_t>(c);
+                word = bit_words[position >> 6];
             }
-            return hash % bit_size;
+            return (word >> (position & 63)) & 1;
         }
 
-        // 哈希函数2：基于SDBM算法
-        uint64_t hash2(const T &item) const
+        void set_bit(size_t position)
         {
-            std::string str = std::to_string(item);
-            uint64_t hash = 0;
-            for (char c : str)
+            uint64_t mask = uint64_t(1) << (position & 63);
+            if constexpr (Concurrent)
+            {
+                // 位已经为1时跳过原子写，避免多线程反复争抢同一缓存行的独占权
+                Word &word = bit_words[position >> 6];
+                if ((word.load(std::memory_order_relaxed) & mask) == 0)
+                {
+                    word.fetch_or(mask, std::memory_order_relaxed);
+                }
+            }
+            else
             {
-                hash = static_cast<uint64_t>(c) + (hash << 6) + (hash << 16) - hash;
+                bit_words[position >> 6] |= mask;
             }
-            return hash % bit_size;
         }
 
-        // 哈希函数3：基于FNV-1a算法
-        uint64_t hash3(const T &item) const
+        // 按预取窗口插入一段元素，不更新item_count
+        void insert_range(const T *items, size_t count, size_t *positions)
         {
-            std::string str = std::to_string(item);
-            uint64_t hash = 14695981039346656037ULL;
-            for (char c : str)
+            for (size_t base = 0; base < count; base += BATCH_WINDOW)
             {
-                hash ^= static_cast<uint64_t>(c);
-                hash *= 1099511628211ULL;
+                size_t window = std::min(BATCH_WINDOW, count - base);
+                prepare_window<1>(items + base, window, positions);
+                for (size_t i = 0; i < window * hash_count; ++i)
+                {
+                    set_bit(positions[i]);
+                }
             }
-            return hash % bit_size;
         }
 
-        // 计算第i个哈希值（组合基础哈希函数）
-        uint64_t get_hash(const T &item, size_t i) const
+        /**
+         * @brief 计算一个窗口内全部元素的探测位置，并预取这些位置所在的缓存行
+         * 窗口内的访存请求同时发出，随后的置位/测试阶段不再逐个等待缓存未命中
+         * @tparam WRITE 预取后是否要写入（insert_batch为1，contains_batch为0）
+         */
+        template <int WRITE>
+        void prepare_window(const T *items, size_t count, size_t *positions) const
         {
-            return (hash1(item) + i * hash2(item) + i * i * hash3(item)) % bit_size;
+            for (size_t j = 0; j < count; ++j)
+            {
+                BloomHash::Hash128 hash = BloomHash::hash(items[j]);
+                for (size_t i = 0; i < hash_count; ++i)
+                {
+                    size_t position = probe(hash, i);
+                    positions[j * hash_count + i] = position;
+                    __builtin_prefetch(&bit_words[position >> 6], WRITE, 3);
+                }
+            }
         }
 
     public:
@@ -88,9 +335,9 @@ namespace CryptoTools
             //hash_count = static_cast<size_t>(std::round((bit_size / expected_items) * std::log(2)));
             if (hash_count == 0)
                 hash_count = 1; // 确保至少有1个哈希函数
-            std::cout <<"hash_count: "<<hash_count<<std::endl;
             // 初始化位数组
-            bit_array.resize(bit_size, false);
+            // std::atomic不可复制，用构造而非assign；C++20起两种字都会值初始化为0
+            bit_words = std::vector<Word>((bit_size + 63) / 64);
             item_count = 0;
         }
 
@@ -100,10 +347,10 @@ namespace CryptoTools
          */
         void insert(const T &item)
         {
+            BloomHash::Hash128 hash = BloomHash::hash(item);
             for (size_t i = 0; i < hash_count; ++i)
             {
-                size_t position = get_hash(item, i);
-                bit_array[position] = true;
+                set_bit(probe(hash, i));
             }
             item_count++;
         }
@@ -115,10 +362,10 @@ namespace CryptoTools
          */
         bool contains(const T &item) const
         {
+            BloomHash::Hash128 hash = BloomHash::hash(item);
             for (size_t i = 0; i < hash_count; ++i)
             {
-                size_t position = get_hash(item, i);
-                if (!bit_array[position])
+                if (!test_bit(probe(hash, i)))
                 {
                     return false; // 只要有一位为0，肯定不存在
                 }
@@ -126,6 +373,138 @@ namespace CryptoTools
             return true; // 所有位都为1，可能存在
         }
 
+        /**
+         * @brief 批量插入元素
+         * 每BATCH_WINDOW个元素为一个窗口：先计算窗口内全部探测位置并预取，再统一置位，使多次缓存未命中相互重叠
+         * @param items 要插入的元素
+         */
+        void insert_batch(std::span<const T> items)
+        {
+            std::vector<size_t> positions(BATCH_WINDOW * hash_count);
+            insert_range(items.data(), items.size(), positions.data());
+            item_count += items.size();
+        }
+
+        /**
+         * @brief 多线程并行插入元素（仅并发模式）
+         * 各线程按PARALLEL_CHUNK领取元素，用预取窗口批量插入，置位通过fetch_or完成，无需加锁。
+         * 可与其他线程的insert/contains同时进行。线程创建失败时由已启动的线程和当前线程完成剩余插入，
+         * 工作线程中的异常在所有线程汇合后重新抛出
+         * @param items 要插入的元素
+         * @param threads 线程数，为0时使用硬件并发数
+         */
+        void insert_parallel(std::span<const T> items, unsigned threads = 0)
+            requires Concurrent
+        {
+            if (threads == 0)
+            {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            size_t chunk_count = (items.size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+            threads = static_cast<unsigned>(std::min<size_t>(threads, chunk_count));
+
+            // 数据量不足以分给多个线程时直接在当前线程插入
+            if (threads <= 1)
+            {
+                insert_batch(items);
+                return;
+            }
+
+            std::atomic<size_t> next_chunk{0};
+            std::vector<std::exception_ptr> errors(threads);
+            auto worker = [&](unsigned index)
+            {
+                try
+                {
+                    std::vector<size_t> positions(BATCH_WINDOW * hash_count);
+                    for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++)
+                    {
+                        size_t begin = chunk * PARALLEL_CHUNK;
+                        insert_range(items.data() + begin, std::min(PARALLEL_CHUNK, items.size() - begin), positions.data());
+                    }
+                }
+                catch (...)
+                {
+                    // 记录异常并让其余线程不再领取新块，所有线程汇合后由调用线程重新抛出
+                    errors[index] = std::current_exception();
+                    next_chunk = chunk_count;
+                }
+            };
+
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; ++t)
+            {
+                try
+                {
+                    pool.emplace_back(worker, t);
+                }
+                catch (const std::system_error &)
+                {
+                    // 无法再创建线程时，由已启动的线程和当前线程领取剩余的块
+                    break;
+                }
+            }
+            // 当前线程也参与插入
+            worker(0);
+            for (auto &thread : pool)
+            {
+                thread.join();
+            }
+            for (const std::exception_ptr &error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+            item_count += items.size();
+        }
+
+        /**
+         * @brief 批量检查元素是否可能存在，结果写入位图
+         * @param items 要检查的元素
+         * @param bitmap 结果位图，第i个元素可能存在时 bitmap[i / 64] 的第 i % 64 位为1，至少需要 ceil(n / 64) 个字
+         */
+        void contains_batch(std::span<const T> items, std::span<uint64_t> bitmap) const
+        {
+            size_t bitmap_words = (items.size() + 63) / 64;
+            if (bitmap.size() < bitmap_words)
+            {
+                throw std::invalid_argument("结果位图长度不足：需要" + std::to_string(bitmap_words) + "个64位字");
+            }
+            std::fill(bitmap.begin(), bitmap.begin() + bitmap_words, 0);
+
+            std::vector<size_t> positions(BATCH_WINDOW * hash_count);
+            for (size_t base = 0; base < items.size(); base += BATCH_WINDOW)
+            {
+                size_t count = std::min(BATCH_WINDOW, items.size() - base);
+                prepare_window<0>(items.data() + base, count, positions.data());
+                for (size_t j = 0; j < count; ++j)
+                {
+                    const size_t *probes = positions.data() + j * hash_count;
+                    bool present = true;
+                    for (size_t i = 0; i < hash_count && present; ++i)
+                    {
+                        present = test_bit(probes[i]);
+                    }
+                    size_t index = base + j;
+                    bitmap[index >> 6] |= uint64_t(present) << (index & 63);
+                }
+            }
+        }
+
+        /**
+         * @brief 批量检查元素是否可能存在
+         * @return 结果位图，第i个元素可能存在时第i位为1
+         */
+        std::vector<uint64_t> contains_batch(std::span<const T> items) const
+        {
+            std::vector<uint64_t> bitmap((items.size() + 63) / 64);
+            contains_batch(items, bitmap);
+            return bitmap;
+        }
+
         /**
          * @brief 获取位数组大小（位）
          */
@@ -155,44 +534,353 @@ namespace CryptoTools
          */
         void clear()
         {
-            std::fill(bit_array.begin(), bit_array.end(), false);
+            std::fill(bit_words.begin(), bit_words.end(), 0);
             item_count = 0;
         }
     };
 
-    // 针对字符串类型的特化，优化哈希计算
-    template <>
-    inline uint64_t BloomFilter<std::string>::hash1(const std::string &item) const
+    // 多线程可同时插入/查询的布隆过滤器
+    template <typename T>
+    using ConcurrentBloomFilter = BloomFilter<T, true>;
+
+    /**
+     * @brief 布隆过滤器误判率计算器
+     *
+     * 标准布隆过滤器的k个位均匀分布在整个位数组上；分块布隆过滤器先选一个512位的块，
+     * 再在块内独立选取k个位。各块的负载服从泊松分布，负载偏高的块误判率更高，
+     * 因此同样的位数下分块布隆过滤器的误判率略高，需要稍多的空间才能达到相同的误判率。
+     */
+    class BloomFilterCalculator
     {
-        uint64_t hash = 5381;
-        for (char c : item)
+    public:
+        /**
+         * @brief 标准布隆过滤器的误判率 (1 - e^(-kn/m))^k
+         * @param items 插入的元素数量n
+         * @param bits 位数组大小m
+         * @param hash_count 哈希函数数量k
+         */
+        static double standard_false_positive_rate(size_t items, size_t bits, size_t hash_count)
         {
-            hash = ((hash << 5) + hash) + static_cast<uint64_t>(c);
+            if (bits == 0)
+            {
+                return 1.0;
+            }
+            double k = static_cast<double>(hash_count);
+            return std::pow(1.0 - std::exp(-k * static_cast<double>(items) / static_cast<double>(bits)), k);
         }
-        return hash % bit_size;
-    }
 
-    template <>
-    inline uint64_t BloomFilter<std::string>::hash2(const std::string &item) const
-    {
-        uint64_t hash = 0;
-        for (char c : item)
+        /**
+         * @brief 分块布隆过滤器的误判率
+         * 块负载i ~ Poisson(λ = n * B / m)；每个元素在块内独立均匀地选取k个位置，
+         * 负载为i的块中某一位为1的概率为 1 - (1 - 1/B)^(k * i)，误判率为 Σ P(i) * (1 - (1 - 1/B)^(k * i))^k
+         * @param items 插入的元素数量n
+         * @param bits 位数组大小m（向上取整到块大小的整数倍）
+         * @param hash_count 每个元素在块内设置的位数k
+         * @param block_bits 块大小B（位）
+         */
+        static double blocked_false_positive_rate(size_t items, size_t bits, size_t hash_count, size_t block_bits = 512)
+        {
+            size_t blocks = (bits + block_bits - 1) / block_bits;
+            if (blocks == 0 || hash_count > block_bits)
+            {
+                return 1.0;
+            }
+            if (items == 0)
+            {
+                return 0.0;
+            }
+
+            double lambda = static_cast<double>(items) / static_cast<double>(blocks);
+            double k = static_cast<double>(hash_count);
+            double keep = std::pow(1.0 - 1.0 / static_cast<double>(block_bits), k);
+            double log_lambda = std::log(lambda);
+
+            // 在λ附近足够宽的区间内求和，区间外的泊松概率可以忽略
+            double spread = 12.0 * std::sqrt(lambda) + 20.0;
+            size_t first = static_cast<size_t>(std::max(0.0, lambda - spread));
+            size_t last = static_cast<size_t>(lambda + spread);
+            double rate = 0.0;
+            for (size_t i = first; i <= last; ++i)
+            {
+                double load = static_cast<double>(i);
+                double probability = std::exp(-lambda + load * log_lambda - std::lgamma(load + 1.0));
+                rate += probability * std::pow(1.0 - std::pow(keep, load), k);
+            }
+            return std::min(rate, 1.0);
+        }
+
+        /**
+         * @brief 给定大小下使分块布隆过滤器误判率最低的哈希函数数量
+         */
+        static size_t optimal_blocked_hash_count(size_t items, size_t bits, size_t block_bits = 512)
         {
-            hash = static_cast<uint64_t>(c) + (hash << 6) + (hash << 16) - hash;
+            size_t best = 1;
+            double best_rate = blocked_false_positive_rate(items, bits, 1, block_bits);
+            for (size_t k = 2; k <= MAX_HASH_COUNT; ++k)
+            {
+                double rate = blocked_false_positive_rate(items, bits, k, block_bits);
+                if (rate < best_rate)
+                {
+                    best = k;
+                    best_rate = rate;
+                }
+            }
+            return best;
         }
-        return hash % bit_size;
-    }
 
-    template <>
-    inline uint64_t BloomFilter<std::string>::hash3(const std::string &item) const
+        // 参数搜索结果
+        struct Parameters
+        {
+            size_t bits;              // 位数组大小（块大小的整数倍）
+            size_t hash_count;        // 哈希函数数量
+            double false_positive_rate; // 该参数下的理论误判率
+        };
+
+        /**
+         * @brief 求达到目标误判率所需的最小分块布隆过滤器
+         * @param items 预期插入的元素数量
+         * @param false_positive_rate 目标误判率，范围(0, 1)
+         * @param block_bits 块大小（位）
+         * @return 最小的块数对应的位数、最佳哈希函数数量与理论误判率
+         */
+        static Parameters blocked_parameters(size_t items, double false_positive_rate, size_t block_bits = 512)
+        {
+            if (false_positive_rate <= 0 || false_positive_rate >= 1)
+            {
+                throw std::invalid_argument("误判率必须在(0, 1)范围内");
+            }
+            items = std::max<size_t>(items, 1);
+
+            auto best_rate = [&](size_t blocks, size_t &hash_count)
+            {
+                hash_count = optimal_blocked_hash_count(items, blocks * block_bits, block_bits);
+                return blocked_false_positive_rate(items, blocks * block_bits, hash_count, block_bits);
+            };
+
+            // 以标准布隆过滤器的理论大小为下界，倍增找到上界后二分
+            size_t hash_count = 1;
+            double ideal_bits = -static_cast<double>(items) * std::log(false_positive_rate) / (std::log(2) * std::log(2));
+            size_t low = std::max<size_t>(1, static_cast<size_t>(ideal_bits / static_cast<double>(block_bits)));
+            size_t high = low;
+            while (best_rate(high, hash_count) > false_positive_rate)
+            {
+                low = high;
+                high *= 2;
+            }
+            while (low < high)
+            {
+                size_t middle = low + (high - low) / 2;
+                if (best_rate(middle, hash_count) <= false_positive_rate)
+                {
+                    high = middle;
+                }
+                else
+                {
+                    low = middle + 1;
+                }
+            }
+
+            double rate = best_rate(high, hash_count);
+            return {high * block_bits, hash_count, rate};
+        }
+
+        // 分块布隆过滤器支持的最大哈希函数数量
+        static constexpr size_t MAX_HASH_COUNT = 16;
+    };
+
+    /**
+     * @brief 分块布隆过滤器（cache-line blocked Bloom filter）
+     *
+     * 位数组划分为64字节（512位）对齐的块，每个元素的k个位全部落在同一个块内：
+     * 一次查询只访问一条缓存行，判断时用SIMD一次比较整个块（AVX2为两次256位testc，AVX-512为一次掩码比较）。
+     * 代价是误判率略高于同样大小的标准布隆过滤器，构造时按 BloomFilterCalculator 的分块公式确定大小。
+     */
+    template <typename T>
+    class BlockedBloomFilter
     {
-        uint64_t hash = 14695981039346656037ULL;
-        for (char c : item)
+    public:
+        static constexpr size_t BLOCK_BITS = 512;
+
+        // 一个缓存行大小的块
+        struct alignas(64) Block
+        {
+            uint64_t words[8];
+        };
+
+        /**
+         * @brief 构造分块布隆过滤器
+         * @param expected_items 预期插入的元素数量
+         * @param false_positive_rate 可接受的误判率
+         * @param hash_count 哈希函数数量，为0时取该大小下的最佳值
+         */
+        BlockedBloomFilter(size_t expected_items, double false_positive_rate, size_t hash_count = 0)
+        {
+            if (expected_items == 0)
+            {
+                throw std::invalid_argument("预期元素数量不能为0");
+            }
+            BloomFilterCalculator::Parameters parameters = BloomFilterCalculator::blocked_parameters(expected_items, false_positive_rate, BLOCK_BITS);
+            if (hash_count > BloomFilterCalculator::MAX_HASH_COUNT)
+            {
+                throw std::invalid_argument("分块布隆过滤器的哈希函数数量不能超过" + std::to_string(BloomFilterCalculator::MAX_HASH_COUNT));
+            }
+            this->hash_count = hash_count == 0 ? parameters.hash_count : hash_count;
+            blocks.assign(parameters.bits / BLOCK_BITS, Block{});
+            item_count = 0;
+        }
+
+        /**
+         * @brief 插入元素到布隆过滤器
+         * @param item 要插入的元素
+         */
+        void insert(const T &item)
         {
-            hash ^= static_cast<uint64_t>(c);
-            hash *= 1099511628211ULL;
+            BloomHash::Hash128 hash = BloomHash::hash(item);
+            Block mask = make_mask(hash.low);
+            Block &block = blocks[BloomHash::reduce(hash.high, blocks.size())];
+            for (int i = 0; i < 8; ++i)
+            {
+                block.words[i] |= mask.words[i];
+            }
+            item_count++;
         }
-        return hash % bit_size;
-    }
+
+        /**
+         * @brief 检查元素是否可能存在于布隆过滤器中
+         * @param item 要检查的元素
+         * @return true：可能存在（有一定误判率）；false：一定不存在
+         */
+        bool contains(const T &item) const
+        {
+            BloomHash::Hash128 hash = BloomHash::hash(item);
+            Block mask = make_mask(hash.low);
+            return block_contains(blocks[BloomHash::reduce(hash.high, blocks.size())], mask);
+        }
+
+        /**
+         * @brief 获取位数组大小（位）
+         */
+        size_t get_bit_size() const
+        {
+            return blocks.size() * BLOCK_BITS;
+        }
+
+        /**
+         * @brief 获取块数量
+         */
+        size_t get_block_count() const
+        {
+            return blocks.size();
+        }
+
+        /**
+         * @brief 获取哈希函数数量
+         */
+        size_t get_hash_count() const
+        {
+            return hash_count;
+        }
+
+        /**
+         * @brief 获取已插入元素数量
+         */
+        size_t get_item_count() const
+        {
+            return item_count;
+        }
+
+        /**
+         * @brief 按当前大小与已插入元素数量估算的理论误判率
+         */
+        double estimated_false_positive_rate() const
+        {
+            return BloomFilterCalculator::blocked_false_positive_rate(item_count, get_bit_size(), hash_count, BLOCK_BITS);
+        }
+
+        /**
+         * @brief 清空布隆过滤器
+         */
+        void clear()
+        {
+            std::fill(blocks.begin(), blocks.end(), Block{});
+            item_count = 0;
+        }
+
+    private:
+        std::vector<Block> blocks; // 按缓存行对齐的块
+        size_t hash_count;         // 每个元素在块内设置的位数
+        size_t item_count;         // 已插入元素数量
+
+        /**
+         * @brief 生成元素在块内的位掩码
+         * 块的选择使用128位哈希的高64位；块内k个位置各取低64位的9位，每个64位值提供7个位置，
+         * 用完后再混合一次得到新的派生值。各位置相互独立，与误判率公式的假设一致
+         */
+        Block make_mask(uint64_t hash) const
+        {
+            Block mask{};
+            uint64_t derived = hash;
+            for (size_t i = 0; i < hash_count; ++i)
+            {
+                if (i != 0 && i % 7 == 0)
+                {
+                    derived = BloomHash::mix(derived);
+                }
+                uint32_t position = static_cast<uint32_t>(derived >> (9 * (i % 7))) & (BLOCK_BITS - 1);
+                mask.words[position >> 6] |= uint64_t(1) << (position & 63);
+            }
+            return mask;
+        }
+
+        // 判断块中是否包含掩码的全部位：(~block & mask) == 0
+        static bool block_contains_scalar(const Block &block, const Block &mask)
+        {
+            uint64_t missing = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                missing |= mask.words[i] & ~block.words[i];
+            }
+            return missing == 0;
+        }
+
+#ifdef BLOOM_FILTER_X86_AVAILABLE
+        BLOOM_FILTER_AVX2_TARGET static bool block_contains_avx2(const Block &block, const Block &mask)
+        {
+            const __m256i *b = reinterpret_cast<const __m256i *>(block.words);
+            const __m256i *m = reinterpret_cast<const __m256i *>(mask.words);
+            return _mm256_testc_si256(_mm256_load_si256(b), _mm256_load_si256(m)) &
+                   _mm256_testc_si256(_mm256_load_si256(b + 1), _mm256_load_si256(m + 1));
+        }
+
+        BLOOM_FILTER_AVX512_TARGET static bool block_contains_avx512(const Block &block, const Block &mask)
+        {
+            // vpternlogq计算 ~block & mask（真值表0x0C），避免GCC的andnot内部使用未初始化值
+            __m512i m = _mm512_load_si512(mask.words);
+            __m512i missing = _mm512_ternarylogic_epi64(_mm512_load_si512(block.words), m, m, 0x0C);
+            return _mm512_test_epi64_mask(missing, missing) == 0;
+        }
+#endif
+
+        static bool block_contains(const Block &block, const Block &mask)
+        {
+            using ContainsFunc = bool (*)(const Block &, const Block &);
+            static const ContainsFunc contains_func = []() -> ContainsFunc
+            {
+#ifdef BLOOM_FILTER_X86_AVAILABLE
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f"))
+                {
+                    return block_contains_avx512;
+                }
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    return block_contains_avx2;
+                }
+#endif
+                return block_contains_scalar;
+            }();
+            return contains_func(block, mask);
+        }
+    };
 }
 #endif // BLOOM_FILTER_HPP
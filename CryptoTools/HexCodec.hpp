@@ -0,0 +1,371 @@
+#ifndef HEX_CODEC_HPP
+#define HEX_CODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HEX_CODEC_X86_AVAILABLE 1
+#define HEX_CODEC_SSSE3_TARGET __attribute__((target("ssse3")))
+#define HEX_CODEC_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace CryptoTools
+{
+    namespace HexTables
+    {
+        /**
+         * @brief 编译期生成字符到半字节的查找表
+         * @return 256项查找表，非法字符为0xFF
+         */
+        constexpr std::array<uint8_t, 256> make_decode_table()
+        {
+            std::array<uint8_t, 256> table{};
+            for (auto &value : table)
+            {
+                value = 0xFF;
+            }
+            for (int i = 0; i < 10; ++i)
+            {
+                table['0' + i] = static_cast<uint8_t>(i);
+            }
+            for (int i = 0; i < 6; ++i)
+            {
+                table['a' + i] = static_cast<uint8_t>(10 + i);
+                table['A' + i] = static_cast<uint8_t>(10 + i);
+            }
+            return table;
+        }
+
+        inline constexpr std::array<uint8_t, 256> DECODE_TABLE = make_decode_table();
+    }
+
+    /**
+     * @brief 十六进制编解码
+     *
+     * 所有接口都写入调用者预先分配的缓冲区（或一次性分配好的字符串），不逐字节拼接。
+     * 编码输出小写字符；解码同时接受大小写字符，遇到非法字符时报告失败。
+     * 运行时按CPU特性选择后端：AVX2每次处理32字节，SSSE3每次处理16字节，剩余部分与不支持SIMD的平台使用查表实现。
+     */
+    class HexCodec
+    {
+    public:
+        // 编解码后端
+        enum class Backend
+        {
+            Scalar, // 可移植的查表实现
+            SSSE3,  // pshufb查表，每次16字节
+            AVX2    // 256位pshufb查表，每次32字节
+        };
+
+        /**
+         * @brief 编码为十六进制字符
+         * @param input 输入字节
+         * @param length 输入长度（字节）
+         * @param output 输出缓冲区，至少2 * length字节；不写入终止符
+         */
+        static void encode(const uint8_t *input, size_t length, char *output)
+        {
+            encoder(detect_backend())(input, length, output);
+        }
+
+        /**
+         * @brief 编码为十六进制字符（指定后端）
+         * @throws std::invalid_argument 当前CPU不支持指定后端时抛出异常
+         */
+        static void encode(const uint8_t *input, size_t length, char *output, Backend backend)
+        {
+            check_backend(backend);
+            encoder(backend)(input, length, output);
+        }
+
+        /**
+         * @brief 编码为十六进制字符串
+         */
+        static std::string encode(std::span<const uint8_t> input)
+        {
+            std::string output(input.size() * 2, '\0');
+            encode(input.data(), input.size(), output.data());
+            return output;
+        }
+
+        /**
+         * @brief 解码十六进制字符
+         * @param input 十六进制字符
+         * @param length 字符数，必须为偶数
+         * @param output 输出缓冲区，至少length / 2字节
+         * @return 全部字符合法返回true；否则返回false，此时output内容未定义
+         */
+        static bool decode(const char *input, size_t length, uint8_t *output)
+        {
+            return length % 2 == 0 && decoder(detect_backend())(input, length / 2, output);
+        }
+
+        /**
+         * @brief 解码十六进制字符（指定后端）
+         * @throws std::invalid_argument 当前CPU不支持指定后端时抛出异常
+         */
+        static bool decode(const char *input, size_t length, uint8_t *output, Backend backend)
+        {
+            check_backend(backend);
+            return length % 2 == 0 && decoder(backend)(input, length / 2, output);
+        }
+
+        /**
+         * @brief 解码十六进制字符串
+         * @throws std::invalid_argument 长度为奇数或包含非法字符时抛出异常
+         */
+        static std::vector<uint8_t> decode(std::string_view hex)
+        {
+            std::vector<uint8_t> output(hex.size() / 2);
+            if (!decode(hex.data(), hex.size(), output.data()))
+            {
+                throw std::invalid_argument("非法的十六进制字符串");
+            }
+            return output;
+        }
+
+        // 检测当前CPU上可用的最快后端（只检测一次）
+        static Backend detect_backend()
+        {
+            static const Backend detected = []
+            {
+                if (backend_supported(Backend::AVX2))
+                {
+                    return Backend::AVX2;
+                }
+                if (backend_supported(Backend::SSSE3))
+                {
+                    return Backend::SSSE3;
+                }
+                return Backend::Scalar;
+            }();
+            return detected;
+        }
+
+        // 判断指定后端在当前CPU上是否可用
+        static bool backend_supported(Backend backend)
+        {
+            switch (backend)
+            {
+            case Backend::Scalar:
+                return true;
+#ifdef HEX_CODEC_X86_AVAILABLE
+            case Backend::SSSE3:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("ssse3");
+            case Backend::AVX2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+#endif
+            default:
+                return false;
+            }
+        }
+
+        // 获取后端名称，便于日志输出
+        static const char *backend_name(Backend backend)
+        {
+            switch (backend)
+            {
+            case Backend::Scalar:
+                return "scalar";
+            case Backend::SSSE3:
+                return "ssse3";
+            case Backend::AVX2:
+                return "avx2";
+            }
+            return "unknown";
+        }
+
+    private:
+        using EncodeFunc = void (*)(const uint8_t *input, size_t length, char *output);
+        using DecodeFunc = bool (*)(const char *input, size_t length, uint8_t *output); // length为输出字节数
+
+        static constexpr char DIGITS[] = "0123456789abcdef";
+
+        static void check_backend(Backend backend)
+        {
+            if (!backend_supported(backend))
+            {
+                throw std::invalid_argument(std::string("当前CPU不支持HexCodec后端: ") + backend_name(backend));
+            }
+        }
+
+        static EncodeFunc encoder(Backend backend)
+        {
+            switch (backend)
+            {
+#ifdef HEX_CODEC_X86_AVAILABLE
+            case Backend::SSSE3:
+                return encode_ssse3;
+            case Backend::AVX2:
+                return encode_avx2;
+#endif
+            default:
+                return encode_scalar;
+            }
+        }
+
+        static DecodeFunc decoder(Backend backend)
+        {
+            switch (backend)
+            {
+#ifdef HEX_CODEC_X86_AVAILABLE
+            case Backend::SSSE3:
+                return decode_ssse3;
+            case Backend::AVX2:
+                return decode_avx2;
+#endif
+            default:
+                return decode_scalar;
+            }
+        }
+
+        static void encode_scalar(const uint8_t *input, size_t length, char *output)
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                output[2 * i] = DIGITS[input[i] >> 4];
+                output[2 * i + 1] = DIGITS[input[i] & 0x0F];
+            }
+        }
+
+        static bool decode_scalar(const char *input, size_t length, uint8_t *output)
+        {
+            uint8_t invalid = 0;
+            for (size_t i = 0; i < length; ++i)
+            {
+                uint8_t high = HexTables::DECODE_TABLE[static_cast<uint8_t>(input[2 * i])];
+                uint8_t low = HexTables::DECODE_TABLE[static_cast<uint8_t>(input[2 * i + 1])];
+                invalid |= high | low;
+                output[i] = static_cast<uint8_t>((high << 4) | (low & 0x0F));
+            }
+            // 合法半字节不超过0x0F，出现0xFF时高位被置位
+            return (invalid & 0xF0) == 0;
+        }
+
+#ifdef HEX_CODEC_X86_AVAILABLE
+        /**
+         * @brief 16字节编码为32个字符：高低半字节分别用pshufb查表，再交错合并
+         */
+        HEX_CODEC_SSSE3_TARGET static inline void encode_block_ssse3(__m128i bytes, char *output)
+        {
+            const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(DIGITS));
+            const __m128i mask = _mm_set1_epi8(0x0F);
+            __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+            __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_unpacklo_epi8(high, low));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), _mm_unpackhi_epi8(high, low));
+        }
+
+        HEX_CODEC_SSSE3_TARGET static void encode_ssse3(const uint8_t *input, size_t length, char *output)
+        {
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                encode_block_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i)), output + 2 * i);
+            }
+            encode_scalar(input + i, length - i, output + 2 * i);
+        }
+
+        HEX_CODEC_AVX2_TARGET static void encode_avx2(const uint8_t *input, size_t length, char *output)
+        {
+            const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(DIGITS)));
+            const __m256i mask = _mm256_set1_epi8(0x0F);
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+                __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+                __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, mask));
+                // unpack在128位通道内交错，重新排列两个通道得到连续输出
+                __m256i first = _mm256_unpacklo_epi8(high, low);
+                __m256i second = _mm256_unpackhi_epi8(high, low);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+            }
+            for (; i + 16 <= length; i += 16)
+            {
+                encode_block_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i)), output + 2 * i);
+            }
+            encode_scalar(input + i, length - i, output + 2 * i);
+        }
+
+        /**
+         * @brief 16个字符转换为半字节并检查合法性
+         * 数字与字母(大小写统一为小写)分别做范围比较，二者都不满足的字符为非法
+         * @param valid 输出的合法性掩码，与输入逐字节对应
+         */
+        HEX_CODEC_SSSE3_TARGET static inline __m128i nibbles_ssse3(__m128i chars, __m128i &valid)
+        {
+            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+            __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+            __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+            valid = _mm_or_si128(digit, alpha);
+            return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                                _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+        }
+
+        HEX_CODEC_SSSE3_TARGET static bool decode_ssse3(const char *input, size_t length, uint8_t *output)
+        {
+            // maddubs把相邻两个半字节合并为 high * 16 + low
+            const __m128i weights = _mm_set1_epi16(0x0110);
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i valid0, valid1;
+                __m128i n0 = nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 2 * i)), valid0);
+                __m128i n1 = nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 2 * i + 16)), valid1);
+                if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xFFFF)
+                {
+                    return false;
+                }
+                __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), bytes);
+            }
+            return decode_scalar(input + 2 * i, length - i, output + i);
+        }
+
+        HEX_CODEC_AVX2_TARGET static bool decode_avx2(const char *input, size_t length, uint8_t *output)
+        {
+            const __m256i weights = _mm256_set1_epi16(0x0110);
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i valid = _mm256_set1_epi8(-1);
+                __m256i words[2];
+                for (int half = 0; half < 2; ++half)
+                {
+                    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + 2 * i + 32 * half));
+                    __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+                    __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+                    __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+                    valid = _mm256_and_si256(valid, _mm256_or_si256(digit, alpha));
+                    __m256i nibbles = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0'))),
+                                                      _mm256_and_si256(alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+                    words[half] = _mm256_maddubs_epi16(nibbles, weights);
+                }
+                if (_mm256_movemask_epi8(valid) != -1)
+                {
+                    return false;
+                }
+                // packus在128位通道内交错，重新排列64位块恢复顺序
+                __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(words[0], words[1]), 0xD8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), bytes);
+            }
+            return decode_ssse3(input + 2 * i, length - i, output + i);
+        }
+#endif
+    };
+
+} // namespace CryptoTools
+
+#endif // HEX_CODEC_HPP
@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <openssl/rand.h>
+#include "HexCodec.hpp"
 
 namespace CryptoTools
 {
@@ -52,10 +53,7 @@ namespace CryptoTools
         }
 
         // 转换为十六进制字符串
-        for (int i = 0; i < num_bytes; ++i)
-        {
-            snprintf(result + i * 2, 3, "%02x", random_bytes[i]);
-        }
+        HexCodec::encode(random_bytes, static_cast<size_t>(num_bytes), result);
         result[str_length - 1] = '\0'; // 显式添加字符串终止符
 
         free(random_bytes);
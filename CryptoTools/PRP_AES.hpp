@@ -4,27 +4,329 @@
 #include <iostream>
 #include <vector>
 #include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <system_error>
+#include <span>
+#include <type_traits>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include "../OPRFTools/AES_Core.h"
 
 namespace CryptoTools
 {
+    // 线程安全：所有成员函数均可被多个线程同时调用。
+    // 原生后端通过OPRFTools::AESCore(与PRF_AES共用的AES引擎)只读取轮密钥；
+    // EVP路径从无锁上下文池中租用独立的EVP上下文，
+    // 上下文由构造时初始化好的模板复制而来，不会重复密钥扩展。
     class PRP_AES
     {
+    public:
+        // 置换使用的加密后端：EVP以外的后端均由AESCore实现
+        enum class Backend
+        {
+            EVP,      // OpenSSL EVP接口
+            Table,    // 可移植的T表实现
+            Bitslice, // 可移植的位切片常数时间实现（加密与解密均为位切片电路）
+            AESNI,    // x86-64 AES-NI硬件指令，8路交错
+            VAES      // x86-64 VAES + AVX-512宽指令，每次推进16个分组
+        };
+
     private:
-        EVP_CIPHER_CTX *enc_ctx;          // 加密上下文
-        EVP_CIPHER_CTX *dec_ctx;          // 解密上下文
+        EVP_CIPHER_CTX *enc_ctx;          // 加密上下文模板（只读，供上下文池复制）
+        EVP_CIPHER_CTX *dec_ctx;          // 解密上下文模板（只读，供上下文池复制）
         int key_len;                      // 密钥长度（位）
         static const int BLOCK_SIZE = 16; // AES固定块大小（16字节）
+        Backend backend;                  // 置换使用的后端
+        OPRFTools::AESCore core;          // 原生AES引擎（EVP后端下不使用）
 
-    public:
-        // 构造函数：初始化密钥和上下文（核心修复：禁用填充）
-        PRP_AES(const unsigned char *key, int key_length) : key_len(key_length)
+        // 上下文池槽位数：同时走EVP路径的线程不超过该数量时，上下文只在首次使用时复制一次
+        static const int CONTEXT_POOL_SIZE = 16;
+
+        // 上下文池槽位：将busy由false置为true的线程独占该槽位中的上下文
+        struct ContextSlot
+        {
+            std::atomic<bool> busy{false};
+            EVP_CIPHER_CTX *enc = nullptr;
+            EVP_CIPHER_CTX *dec = nullptr;
+        };
+        mutable ContextSlot context_pool[CONTEXT_POOL_SIZE];
+
+        // 租用的一对加解密上下文，析构时归还到池中
+        // 池中槽位全部被占用时临时复制一对上下文，用完即释放
+        class ContextLease
+        {
+        public:
+            EVP_CIPHER_CTX *enc = nullptr;
+            EVP_CIPHER_CTX *dec = nullptr;
+
+            explicit ContextLease(const PRP_AES &prp)
+            {
+                // 从与线程相关的位置开始查找，减少不同线程争用同一槽位
+                size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+                for (int i = 0; i < CONTEXT_POOL_SIZE; ++i)
+                {
+                    ContextSlot &candidate = prp.context_pool[(start + i) % CONTEXT_POOL_SIZE];
+                    bool expected = false;
+                    if (!candidate.busy.load(std::memory_order_relaxed) &&
+                        candidate.busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    {
+                        slot = &candidate;
+                        break;
+                    }
+                }
+                if (slot && slot->enc)
+                {
+                    enc = slot->enc;
+                    dec = slot->dec;
+                    return;
+                }
+
+                // 槽位首次使用或池已满：从模板复制（模板构造后不再修改，可并发读取）
+                enc = EVP_CIPHER_CTX_new();
+                dec = EVP_CIPHER_CTX_new();
+                if (!enc || !dec || EVP_CIPHER_CTX_copy(enc, prp.enc_ctx) != 1 || EVP_CIPHER_CTX_copy(dec, prp.dec_ctx) != 1)
+                {
+                    EVP_CIPHER_CTX_free(enc);
+                    EVP_CIPHER_CTX_free(dec);
+                    if (slot)
+                    {
+                        slot->busy.store(false, std::memory_order_release);
+                    }
+                    throw std::runtime_error("无法复制密码上下文");
+                }
+                if (slot)
+                {
+                    slot->enc = enc;
+                    slot->dec = dec;
+                }
+            }
+
+            ~ContextLease()
+            {
+                if (slot)
+                {
+                    slot->busy.store(false, std::memory_order_release);
+                }
+                else
+                {
+                    EVP_CIPHER_CTX_free(enc);
+                    EVP_CIPHER_CTX_free(dec);
+                }
+            }
+
+            ContextLease(const ContextLease &) = delete;
+            ContextLease &operator=(const ContextLease &) = delete;
+
+        private:
+            ContextSlot *slot = nullptr;
+        };
+
+        // 原生引擎对应的后端；EVP后端下引擎不参与运算，使用无需CPU特性的查表后端
+        static OPRFTools::AESBackend core_backend(Backend backend_choice)
+        {
+            switch (backend_choice)
+            {
+            case Backend::Bitslice:
+                return OPRFTools::AESBackend::Bitslice;
+            case Backend::AESNI:
+                return OPRFTools::AESBackend::AESNI;
+            case Backend::VAES:
+                return OPRFTools::AESBackend::VAES;
+            case Backend::EVP:
+            case Backend::Table:
+                break;
+            }
+            return OPRFTools::AESBackend::Table;
+        }
+
+        // 在扩展密钥之前校验密钥长度与后端
+        static const unsigned char *checked_key(const unsigned char *key, int key_length, Backend backend_choice)
         {
             if (key_length != 128 && key_length != 192 && key_length != 256)
             {
                 throw std::invalid_argument("AES密钥长度必须是128、192或256位");
             }
+            if (!backend_supported(backend_choice))
+            {
+                throw std::invalid_argument(std::string("当前CPU不支持PRP_AES后端: ") + backend_name(backend_choice));
+            }
+            return key;
+        }
+
+        // 使用给定上下文处理整段数据；EVP的长度参数为int，超长数据按块对齐分段
+        static void evp_update(EVP_CIPHER_CTX *ctx, bool encrypt, const unsigned char *input, unsigned char *output, size_t length)
+        {
+            const size_t max_chunk = (INT_MAX / BLOCK_SIZE) * BLOCK_SIZE;
+            while (length > 0)
+            {
+                int chunk = static_cast<int>(length < max_chunk ? length : max_chunk);
+                int out_len = 0;
+                int ok = encrypt ? EVP_EncryptUpdate(ctx, output, &out_len, input, chunk)
+                                 : EVP_DecryptUpdate(ctx, output, &out_len, input, chunk);
+                if (ok != 1 || out_len != chunk)
+                {
+                    throw std::runtime_error(encrypt ? "置换操作失败" : "逆置换操作失败");
+                }
+                input += chunk;
+                output += chunk;
+                length -= chunk;
+            }
+        }
+
+        // 把block_count个分组切分为至多threads个连续分片并行处理，func(begin, count)处理一个分片
+        // threads为0时使用硬件并发线程数；工作线程抛出的异常在汇合后重新抛出，线程创建失败时剩余分片由当前线程处理
+        template <typename Func>
+        static void run_sharded(size_t block_count, unsigned threads, Func &&func)
+        {
+            // 每个分片至少包含的分组数，过小的分片线程启动开销大于收益
+            const size_t MIN_SHARD_BLOCKS = 4096;
+
+            if (threads == 0)
+            {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            size_t max_shards = (block_count + MIN_SHARD_BLOCKS - 1) / MIN_SHARD_BLOCKS;
+            size_t shard_count = std::min<size_t>(threads, max_shards);
+            if (shard_count <= 1)
+            {
+                func(size_t(0), block_count);
+                return;
+            }
+
+            size_t shard_blocks = (block_count + shard_count - 1) / shard_count;
+            std::vector<std::exception_ptr> errors(shard_count);
+            std::vector<std::thread> workers;
+            workers.reserve(shard_count - 1);
+            auto run_shard = [&](size_t shard)
+            {
+                size_t begin = shard * shard_blocks;
+                size_t count = std::min(shard_blocks, block_count - begin);
+                try
+                {
+                    func(begin, count);
+                }
+                catch (...)
+                {
+                    errors[shard] = std::current_exception();
+                }
+            };
+            size_t started = 1;
+            for (; started < shard_count; ++started)
+            {
+                try
+                {
+                    workers.emplace_back(run_shard, started);
+                }
+                catch (const std::system_error &)
+                {
+                    // 无法再创建线程时，尚未分配出去的分片由当前线程处理
+                    break;
+                }
+            }
+            run_shard(0);
+            for (size_t shard = started; shard < shard_count; ++shard)
+            {
+                run_shard(shard);
+            }
+            for (std::thread &worker : workers)
+            {
+                worker.join();
+            }
+            for (const std::exception_ptr &error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        // CTR模式核心：按批生成计数器分组并批量加密得到密钥流，xor_into为true时异或进data，否则直接写出
+        void ctr_process(const unsigned char *iv, unsigned char *data, size_t length, uint64_t block_offset, bool xor_into) const
+        {
+            // 每批生成的计数器分组数
+            const size_t CTR_BATCH_BLOCKS = 256;
+
+            // 初始计数器视为128位大端整数(high, low)，加上分组偏移
+            uint64_t high = 0;
+            uint64_t low = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                high = (high << 8) | iv[i];
+                low = (low << 8) | iv[8 + i];
+            }
+            low += block_offset;
+            if (low < block_offset)
+            {
+                ++high;
+            }
+
+            alignas(16) unsigned char keystream[CTR_BATCH_BLOCKS * BLOCK_SIZE];
+            for (size_t pos = 0; pos < length;)
+            {
+                size_t bytes = std::min(CTR_BATCH_BLOCKS * BLOCK_SIZE, length - pos);
+                size_t blocks = (bytes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+                for (size_t b = 0; b < blocks; ++b)
+                {
+                    // 逐字节写出大端计数器，与主机字节序无关(编译器会合并为一次字节交换存储)
+                    unsigned char *counter = keystream + b * BLOCK_SIZE;
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        counter[i] = static_cast<unsigned char>(high >> (56 - 8 * i));
+                        counter[8 + i] = static_cast<unsigned char>(low >> (56 - 8 * i));
+                    }
+                    if (++low == 0)
+                    {
+                        ++high;
+                    }
+                }
+                permute_blocks(keystream, keystream, blocks);
+
+                if (xor_into)
+                {
+                    // 按64位字异或，尾部不足8字节的部分逐字节处理
+                    size_t i = 0;
+                    for (; i + 8 <= bytes; i += 8)
+                    {
+                        uint64_t word;
+                        uint64_t mask;
+                        memcpy(&word, data + pos + i, 8);
+                        memcpy(&mask, keystream + i, 8);
+                        word ^= mask;
+                        memcpy(data + pos + i, &word, 8);
+                    }
+                    for (; i < bytes; ++i)
+                    {
+                        data[pos + i] ^= keystream[i];
+                    }
+                }
+                else
+                {
+                    memcpy(data + pos, keystream, bytes);
+                }
+                pos += bytes;
+            }
+            OPENSSL_cleanse(keystream, sizeof(keystream));
+        }
+
+    public:
+        // 构造函数：初始化密钥和上下文（核心修复：禁用填充），批量置换自动选择最快后端
+        PRP_AES(const unsigned char *key, int key_length) : PRP_AES(key, key_length, detect_backend())
+        {
+        }
+
+        // 构造函数：指定批量置换后端（后端不被当前CPU支持时抛出异常）
+        PRP_AES(const unsigned char *key, int key_length, Backend backend_choice)
+            : key_len(key_length), backend(backend_choice),
+              core(checked_key(key, key_length, backend_choice), key_length / 8, core_backend(backend_choice))
+        {
 
             // 创建加密上下文
             enc_ctx = EVP_CIPHER_CTX_new();
@@ -79,9 +381,14 @@ namespace CryptoTools
             EVP_CIPHER_CTX_set_padding(dec_ctx, 0); // 禁用解密填充
         }
 
-        // 析构函数：释放上下文资源
+        // 析构函数：释放上下文资源（轮密钥由AESCore析构时清除）
         ~PRP_AES()
         {
+            for (ContextSlot &slot : context_pool)
+            {
+                EVP_CIPHER_CTX_free(slot.enc);
+                EVP_CIPHER_CTX_free(slot.dec);
+            }
             EVP_CIPHER_CTX_free(enc_ctx);
             EVP_CIPHER_CTX_free(dec_ctx);
         }
@@ -109,82 +416,169 @@ namespace CryptoTools
         // 置换操作（加密）：仅处理16字节完整块
         void permute(const unsigned char *input, unsigned char *output) const
         {
-            int out_len = 0;
+            // 原生后端：不经过EVP上下文
+            if (backend != Backend::EVP)
+            {
+                core.encrypt_block(input, output);
+                return;
+            }
             // 禁用填充后，无需EVP_EncryptFinal_ex（仅需EVP_EncryptUpdate）
-            if (EVP_EncryptUpdate(enc_ctx, output, &out_len, input, BLOCK_SIZE) != 1)
+            ContextLease lease(*this);
+            evp_update(lease.enc, true, input, output, BLOCK_SIZE);
+        }
+
+        // 批量置换：对block_count个相互独立的16字节块加密，output可与input相同
+        // 原生后端一次推进多个分组；EVP后端把整段数据交给一次EVP_EncryptUpdate
+        void permute_blocks(const unsigned char *input, unsigned char *output, size_t block_count) const
+        {
+            if (backend != Backend::EVP)
             {
-                throw std::runtime_error("置换操作失败");
+                core.encrypt_blocks(input, output, block_count);
+                return;
             }
-            // 验证输出长度是否为16字节（确保无异常）
-            if (out_len != BLOCK_SIZE)
+
+            if (block_count > 0)
             {
-                throw std::runtime_error("置换输出长度异常");
+                ContextLease lease(*this);
+                evp_update(lease.enc, true, input, output, block_count * BLOCK_SIZE);
             }
         }
 
+        // 多线程批量置换：将数据切分为连续的分片，各线程同时置换互不重叠的分片
+        // threads为0时使用硬件并发线程数；结果与permute_blocks完全一致
+        void permute_blocks_parallel(const unsigned char *input, unsigned char *output, size_t block_count, unsigned threads = 0) const
+        {
+            run_sharded(block_count, threads, [&](size_t begin, size_t count)
+                        { permute_blocks(input + begin * BLOCK_SIZE, output + begin * BLOCK_SIZE, count); });
+        }
+
+        // CTR模式：data ^= AES(iv + block_offset), AES(iv + block_offset + 1), ...
+        // iv为16字节初始计数器块，按128位大端整数递增，与OpenSSL的AES-CTR输出一致；
+        // data的第一个字节对应第block_offset个计数器分组，length可以不是16的倍数。
+        // 加密与解密是同一操作，可原地处理任意长度的缓冲区
+        void ctr_xor(const unsigned char *iv, unsigned char *data, size_t length, uint64_t block_offset = 0) const
+        {
+            ctr_process(iv, data, length, block_offset, true);
+        }
+
+        // CTR模式，直接作用于任意平凡可复制类型的序列（如std::vector<double>），原地加/解密
+        template <typename T>
+        void ctr_xor(const unsigned char *iv, std::span<T> data, uint64_t block_offset = 0) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "CTR模式只能处理平凡可复制类型");
+            ctr_xor(iv, reinterpret_cast<unsigned char *>(data.data()), data.size_bytes(), block_offset);
+        }
+
+        // CTR模式密钥流：output写满length字节密钥流，第一个字节对应第block_offset个计数器分组
+        void ctr_keystream(const unsigned char *iv, unsigned char *output, size_t length, uint64_t block_offset = 0) const
+        {
+            ctr_process(iv, output, length, block_offset, false);
+        }
+
+        // 多线程CTR模式：把计数器空间切分为连续的分片，各线程处理互不重叠的数据段
+        // 每个分片的计数器可直接由分片起点算出，结果与单线程ctr_xor完全一致
+        void ctr_xor_parallel(const unsigned char *iv, unsigned char *data, size_t length, unsigned threads = 0) const
+        {
+            size_t block_count = (length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            run_sharded(block_count, threads, [&](size_t begin, size_t count)
+                        {
+                size_t offset = begin * BLOCK_SIZE;
+                size_t bytes = std::min(count * BLOCK_SIZE, length - offset);
+                ctr_xor(iv, data + offset, bytes, begin); });
+        }
+
+        // 多线程CTR模式，直接作用于任意平凡可复制类型的序列
+        template <typename T>
+        void ctr_xor_parallel(const unsigned char *iv, std::span<T> data, unsigned threads = 0) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "CTR模式只能处理平凡可复制类型");
+            ctr_xor_parallel(iv, reinterpret_cast<unsigned char *>(data.data()), data.size_bytes(), threads);
+        }
+
         // 逆置换操作（解密）：仅处理16字节完整块
         void inverse_permute(const unsigned char *input, unsigned char *output) const
         {
-            int out_len = 0;
+            if (backend != Backend::EVP)
+            {
+                core.decrypt_block(input, output);
+                return;
+            }
             // 禁用填充后，无需EVP_DecryptFinal_ex（仅需EVP_DecryptUpdate）
-            if (EVP_DecryptUpdate(dec_ctx, output, &out_len, input, BLOCK_SIZE) != 1)
+            ContextLease lease(*this);
+            evp_update(lease.dec, false, input, output, BLOCK_SIZE);
+        }
+
+        // 批量逆置换：对block_count个相互独立的16字节块解密，output可与input相同
+        // 原生后端一次推进多个分组；EVP后端把整段数据交给一次EVP_DecryptUpdate
+        void inverse_permute_blocks(const unsigned char *input, unsigned char *output, size_t block_count) const
+        {
+            if (backend != Backend::EVP)
             {
-                throw std::runtime_error("逆置换操作失败");
+                core.decrypt_blocks(input, output, block_count);
+                return;
             }
-            // 验证输出长度是否为16字节（确保无异常）
-            if (out_len != BLOCK_SIZE)
+
+            if (block_count > 0)
             {
-                throw std::runtime_error("逆置换输出长度异常");
+                ContextLease lease(*this);
+                evp_update(lease.dec, false, input, output, block_count * BLOCK_SIZE);
             }
         }
 
-        // 处理任意长度数据的置换（统一零填充）
-        std::vector<unsigned char> permute_data(const unsigned char *data, size_t length) const
+        // 零填充后的长度：置换length字节数据所需的输出缓冲区大小
+        static size_t padded_length(size_t length)
+        {
+            return (length + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        }
+
+        // 处理任意长度数据的置换（统一零填充），结果写入调用方缓冲区
+        // output至少padded_length(length)字节；output可与data相同（原地置换），
+        // 此时data所在缓冲区同样需要padded_length(length)字节
+        void permute_data(const unsigned char *data, size_t length, unsigned char *output) const
         {
-            std::vector<unsigned char> result;
             size_t full_blocks = length / BLOCK_SIZE;
             size_t remaining = length % BLOCK_SIZE;
 
-            // 处理完整块
-            for (size_t i = 0; i < full_blocks; ++i)
-            {
-                unsigned char block[BLOCK_SIZE];
-                permute(&data[i * BLOCK_SIZE], block);
-                result.insert(result.end(), block, block + BLOCK_SIZE);
-            }
+            // 所有完整块一次性交给批量置换
+            permute_blocks(data, output, full_blocks);
 
             // 处理剩余字节（零填充到16字节后置换，保留完整块）
             if (remaining > 0)
             {
                 unsigned char block[BLOCK_SIZE] = {0}; // 零填充
                 memcpy(block, &data[full_blocks * BLOCK_SIZE], remaining);
-                permute(block, block);
-                result.insert(result.end(), block, block + BLOCK_SIZE);
+                permute(block, &output[full_blocks * BLOCK_SIZE]);
             }
+        }
 
+        // 处理任意长度数据的置换（统一零填充）
+        std::vector<unsigned char> permute_data(const unsigned char *data, size_t length) const
+        {
+            std::vector<unsigned char> result(padded_length(length));
+            permute_data(data, length, result.data());
             return result;
         }
 
-        // 处理任意长度数据的逆置换（对应零填充逻辑）
-        std::vector<unsigned char> inverse_permute_data(const unsigned char *data, size_t length) const
+        // 处理任意长度数据的逆置换，结果写入调用方缓冲区（output至少length字节，可与data相同）
+        void inverse_permute_data(const unsigned char *data, size_t length, unsigned char *output) const
         {
             // 校验输入长度是否为16字节的整数倍（置换后数据必为完整块）
             if (length % BLOCK_SIZE != 0)
             {
                 throw std::invalid_argument("逆置换输入长度必须是16字节的整数倍");
             }
+            inverse_permute_blocks(data, output, length / BLOCK_SIZE);
+        }
 
-            std::vector<unsigned char> result;
-            size_t full_blocks = length / BLOCK_SIZE;
-
-            // 处理所有完整块
-            for (size_t i = 0; i < full_blocks; ++i)
+        // 处理任意长度数据的逆置换（对应零填充逻辑）
+        std::vector<unsigned char> inverse_permute_data(const unsigned char *data, size_t length) const
+        {
+            if (length % BLOCK_SIZE != 0)
             {
-                unsigned char block[BLOCK_SIZE];
-                inverse_permute(&data[i * BLOCK_SIZE], block);
-                result.insert(result.end(), block, block + BLOCK_SIZE);
+                throw std::invalid_argument("逆置换输入长度必须是16字节的整数倍");
             }
-
+            std::vector<unsigned char> result(length);
+            inverse_permute_data(data, length, result.data());
             return result;
         }
 
@@ -193,6 +587,44 @@ namespace CryptoTools
 
         // 获取AES块大小（字节）
         static int get_block_size() { return BLOCK_SIZE; }
+
+        // 获取批量置换使用的后端
+        Backend get_backend() const { return backend; }
+
+        // 检测当前CPU上可用的最快批量置换后端
+        static Backend detect_backend()
+        {
+            // 没有AES指令时OpenSSL自带常数时间的向量化实现，优先于可移植后端
+            switch (OPRFTools::AESCore::detect_backend())
+            {
+            case OPRFTools::AESBackend::VAES:
+                return Backend::VAES;
+            case OPRFTools::AESBackend::AESNI:
+                return Backend::AESNI;
+            default:
+                return Backend::EVP;
+            }
+        }
+
+        // 判断指定后端在当前CPU上是否可用
+        static bool backend_supported(Backend backend_choice)
+        {
+            if (backend_choice == Backend::EVP)
+            {
+                return true;
+            }
+            return OPRFTools::AESCore::backend_supported(core_backend(backend_choice));
+        }
+
+        // 获取后端名称，便于日志输出
+        static const char *backend_name(Backend backend_choice)
+        {
+            if (backend_choice == Backend::EVP)
+            {
+                return "evp";
+            }
+            return OPRFTools::AESCore::backend_name(core_backend(backend_choice));
+        }
     };
 
     // 辅助函数：打印字节数组
@@ -0,0 +1,257 @@
+#ifndef SMALL_DOMAIN_PRP_HPP
+#define SMALL_DOMAIN_PRP_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "PRP_AES.hpp"
+
+namespace CryptoTools
+{
+    // 任意定义域[0, N)上的伪随机置换（保格式加密）
+    // 在覆盖[0, N)的最小2^b定义域上运行以PRP_AES为轮函数的Feistel网络，
+    // 结果落在[N, 2^b)时继续置换（cycle walking），直到回到[0, N)。
+    // 由于2^b < 2N，每个元素平均置换不超过2次。
+    // 线程安全性与PRP_AES一致：所有成员函数均可被多个线程同时调用。
+    class SmallDomainPRP
+    {
+    private:
+        PRP_AES prp;          // 轮函数
+        uint64_t domain;      // 定义域大小N
+        int left_bits;        // Feistel左半部分位数
+        int right_bits;       // Feistel右半部分位数
+        uint64_t left_mask;   // 左半部分掩码
+        uint64_t right_mask;  // 右半部分掩码
+        static const int ROUNDS = 10;       // Feistel轮数
+        static constexpr size_t BATCH_SIZE = 256; // 批量模式每次交给PRP_AES的分组数
+
+        // 构造轮函数输入：字节0为轮号，字节4~11为N（小端），字节12~15为半部分取值（小端）
+        // 把N编入输入，使不同定义域下的置换相互独立
+        void make_round_input(int round, uint64_t half, unsigned char *block) const
+        {
+            memset(block, 0, 16);
+            block[0] = static_cast<unsigned char>(round);
+            for (int i = 0; i < 8; ++i)
+            {
+                block[4 + i] = static_cast<unsigned char>(domain >> (8 * i));
+            }
+            for (int i = 0; i < 4; ++i)
+            {
+                block[12 + i] = static_cast<unsigned char>(half >> (8 * i));
+            }
+        }
+
+        // 取轮函数输出的前8字节（小端）
+        static uint64_t load_round_output(const unsigned char *block)
+        {
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                value |= static_cast<uint64_t>(block[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        // 将第round轮的轮函数输出作用到value上；偶数轮更新左半部分，奇数轮更新右半部分
+        // 异或Feistel的每一轮都是自身的逆，逆置换只需倒序执行各轮
+        uint64_t apply_round(int round, uint64_t value, uint64_t round_output) const
+        {
+            if (round % 2 == 0)
+            {
+                return value ^ ((round_output & left_mask) << right_bits);
+            }
+            return value ^ (round_output & right_mask);
+        }
+
+        // 第round轮轮函数的输入来自未被更新的另一半
+        uint64_t round_source(int round, uint64_t value) const
+        {
+            return round % 2 == 0 ? value & right_mask : value >> right_bits;
+        }
+
+        // 在[0, 2^b)上执行一次完整的Feistel置换（inverse为true时执行逆置换）
+        uint64_t feistel(uint64_t value, bool inverse) const
+        {
+            unsigned char block[16];
+            for (int i = 0; i < ROUNDS; ++i)
+            {
+                int round = inverse ? ROUNDS - 1 - i : i;
+                make_round_input(round, round_source(round, value), block);
+                prp.permute(block, block);
+                value = apply_round(round, value, load_round_output(block));
+            }
+            return value;
+        }
+
+        // 校验整段输入都在[0, N)内，须在写入任何输出之前调用，避免抛出异常时留下部分置换的数据
+        void check_domain(const uint64_t *values, size_t count) const
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (values[i] >= domain)
+                {
+                    throw std::out_of_range("SmallDomainPRP输入超出定义域");
+                }
+            }
+        }
+
+        // 批量置换的核心：values中的每个元素原地置换，每一轮把所有待处理元素的轮函数输入
+        // 一次性交给PRP_AES::permute_blocks，由硬件后端同时推进多个分组
+        // 调用前须已通过check_domain校验全部输入
+        void feistel_batch(uint64_t *values, size_t count, bool inverse) const
+        {
+            alignas(16) unsigned char blocks[BATCH_SIZE * 16];
+            size_t pending[BATCH_SIZE];
+
+            for (size_t base = 0; base < count; base += BATCH_SIZE)
+            {
+                size_t n = std::min(BATCH_SIZE, count - base);
+                uint64_t *chunk = values + base;
+
+                size_t pending_count = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    pending[pending_count++] = i;
+                }
+
+                // 每次循环对仍在[N, 2^b)之外或尚未置换的元素执行一次完整的Feistel置换
+                while (pending_count > 0)
+                {
+                    for (int i = 0; i < ROUNDS; ++i)
+                    {
+                        int round = inverse ? ROUNDS - 1 - i : i;
+                        for (size_t j = 0; j < pending_count; ++j)
+                        {
+                            make_round_input(round, round_source(round, chunk[pending[j]]), blocks + 16 * j);
+                        }
+                        prp.permute_blocks(blocks, blocks, pending_count);
+                        for (size_t j = 0; j < pending_count; ++j)
+                        {
+                            uint64_t &value = chunk[pending[j]];
+                            value = apply_round(round, value, load_round_output(blocks + 16 * j));
+                        }
+                    }
+
+                    // cycle walking：只保留落在定义域之外的元素
+                    size_t remaining = 0;
+                    for (size_t j = 0; j < pending_count; ++j)
+                    {
+                        if (chunk[pending[j]] >= domain)
+                        {
+                            pending[remaining++] = pending[j];
+                        }
+                    }
+                    pending_count = remaining;
+                }
+            }
+        }
+
+    public:
+        // 构造函数：key_length为128、192或256位，domain_size为定义域大小N（N >= 1）
+        SmallDomainPRP(const unsigned char *key, int key_length, uint64_t domain_size)
+            : prp(key, key_length), domain(domain_size)
+        {
+            if (domain_size == 0)
+            {
+                throw std::invalid_argument("SmallDomainPRP定义域大小必须大于0");
+            }
+
+            // 覆盖[0, N)的最小位数b，至少为2以保证两个半部分都非空
+            int bits = 2;
+            while (bits < 64 && (uint64_t(1) << bits) < domain_size)
+            {
+                ++bits;
+            }
+            left_bits = bits - bits / 2;
+            right_bits = bits / 2;
+            left_mask = (uint64_t(1) << left_bits) - 1;
+            right_mask = (uint64_t(1) << right_bits) - 1;
+        }
+
+        // 禁用拷贝构造和赋值（与PRP_AES一致）
+        SmallDomainPRP(const SmallDomainPRP &) = delete;
+        SmallDomainPRP &operator=(const SmallDomainPRP &) = delete;
+
+        // 置换单个元素：x必须在[0, N)内
+        uint64_t permute(uint64_t x) const
+        {
+            if (x >= domain)
+            {
+                throw std::out_of_range("SmallDomainPRP输入超出定义域");
+            }
+            do
+            {
+                x = feistel(x, false);
+            } while (x >= domain);
+            return x;
+        }
+
+        // 逆置换单个元素：y必须在[0, N)内
+        uint64_t inverse_permute(uint64_t y) const
+        {
+            if (y >= domain)
+            {
+                throw std::out_of_range("SmallDomainPRP输入超出定义域");
+            }
+            do
+            {
+                y = feistel(y, true);
+            } while (y >= domain);
+            return y;
+        }
+
+        // 批量置换：outputs[i] = permute(inputs[i])，outputs可与inputs为同一序列
+        // 不生成置换表，内存占用与N无关
+        void permute_batch(std::span<const uint64_t> inputs, std::span<uint64_t> outputs) const
+        {
+            if (outputs.size() != inputs.size())
+            {
+                throw std::invalid_argument("SmallDomainPRP批量输出数量必须与输入数量一致");
+            }
+            check_domain(inputs.data(), inputs.size());
+            if (outputs.data() != inputs.data())
+            {
+                std::copy(inputs.begin(), inputs.end(), outputs.begin());
+            }
+            feistel_batch(outputs.data(), outputs.size(), false);
+        }
+
+        // 原地批量置换
+        void permute_batch(std::span<uint64_t> values) const
+        {
+            check_domain(values.data(), values.size());
+            feistel_batch(values.data(), values.size(), false);
+        }
+
+        // 批量逆置换：outputs[i] = inverse_permute(inputs[i])，outputs可与inputs为同一序列
+        void inverse_permute_batch(std::span<const uint64_t> inputs, std::span<uint64_t> outputs) const
+        {
+            if (outputs.size() != inputs.size())
+            {
+                throw std::invalid_argument("SmallDomainPRP批量输出数量必须与输入数量一致");
+            }
+            check_domain(inputs.data(), inputs.size());
+            if (outputs.data() != inputs.data())
+            {
+                std::copy(inputs.begin(), inputs.end(), outputs.begin());
+            }
+            feistel_batch(outputs.data(), outputs.size(), true);
+        }
+
+        // 原地批量逆置换
+        void inverse_permute_batch(std::span<uint64_t> values) const
+        {
+            check_domain(values.data(), values.size());
+            feistel_batch(values.data(), values.size(), true);
+        }
+
+        // 获取定义域大小N
+        uint64_t domain_size() const { return domain; }
+    };
+
+} // namespace CryptoTools
+
+#endif // SMALL_DOMAIN_PRP_HPP
@@ -0,0 +1,227 @@
+#ifndef HMAC_SHA256_HPP
+#define HMAC_SHA256_HPP
+
+#include "SHA256.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief HMAC-SHA256（RFC 2104）
+ *
+ * 构造时分别压缩 key ^ ipad 与 key ^ opad 两个分组，并保存压缩后的中间状态（midstate）。
+ * 之后每次计算MAC只需从中间状态继续：消息不超过55字节时，内层与外层各一次压缩，共两次，
+ * 而不是从头计算时的四次。同一密钥需要派生大量子密钥时应复用同一个对象。
+ * 所有成员函数均为const，多个线程可同时使用同一对象。
+ */
+class HMAC_SHA256
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 64;  // SHA-256分组长度
+    static constexpr size_t OUTPUT_SIZE = 32; // 输出长度
+
+    /**
+     * @brief 构造函数：预计算内外层中间状态
+     * @param key 密钥（任意长度，超过64字节时先做一次SHA-256）
+     * @param key_len 密钥长度（字节）
+     */
+    HMAC_SHA256(const uint8_t *key, size_t key_len)
+    {
+        uint8_t block[BLOCK_SIZE] = {0};
+        if (key_len > BLOCK_SIZE)
+        {
+            SHA256 sha256;
+            sha256.input(key, key_len);
+            std::array<uint8_t, 32> hashed = sha256.digest();
+            std::memcpy(block, hashed.data(), hashed.size());
+        }
+        else if (key_len > 0)
+        {
+            std::memcpy(block, key, key_len);
+        }
+
+        // 内层：key ^ 0x36...
+        for (uint8_t &b : block)
+        {
+            b ^= 0x36;
+        }
+        m_inner.update(block, BLOCK_SIZE);
+
+        // 外层：key ^ 0x5c...（在已异或0x36的基础上再异或0x36 ^ 0x5c）
+        for (uint8_t &b : block)
+        {
+            b ^= 0x36 ^ 0x5c;
+        }
+        m_outer.update(block, BLOCK_SIZE);
+
+        secure_zero(block, sizeof(block));
+    }
+
+    /**
+     * @brief 构造函数（字符串密钥，重载）
+     */
+    explicit HMAC_SHA256(std::string_view key)
+        : HMAC_SHA256(reinterpret_cast<const uint8_t *>(key.data()), key.size())
+    {
+    }
+
+    // 析构时清除与密钥相关的中间状态
+    ~HMAC_SHA256()
+    {
+        m_inner.reset();
+        m_outer.reset();
+    }
+
+    /**
+     * @brief 计算消息的MAC
+     * @param data 消息
+     * @param length 消息长度（字节）
+     * @return 32字节MAC
+     */
+    std::array<uint8_t, 32> compute(const uint8_t *data, size_t length) const
+    {
+        SHA256 inner = m_inner;
+        inner.update(data, length);
+        return finish(inner);
+    }
+
+    /**
+     * @brief 计算消息的MAC（字符串形式，重载）
+     */
+    std::array<uint8_t, 32> compute(std::string_view data) const
+    {
+        return compute(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    }
+
+    /**
+     * @brief 计算多段拼接消息的MAC：MAC(parts[0] || parts[1] || ...)
+     * 拼接在压缩过程中完成，不需要额外复制消息
+     */
+    std::array<uint8_t, 32> compute(std::initializer_list<std::string_view> parts) const
+    {
+        SHA256 inner = m_inner;
+        for (std::string_view part : parts)
+        {
+            inner.update(part);
+        }
+        return finish(inner);
+    }
+
+private:
+    SHA256 m_inner; // 压缩 key ^ ipad 之后的中间状态
+    SHA256 m_outer; // 压缩 key ^ opad 之后的中间状态
+
+    // 外层：从opad中间状态继续压缩内层哈希
+    std::array<uint8_t, 32> finish(SHA256 &inner) const
+    {
+        std::array<uint8_t, 32> inner_hash = inner.digest();
+        SHA256 outer = m_outer;
+        outer.update(inner_hash.data(), inner_hash.size());
+        return outer.digest();
+    }
+
+    // 清零敏感数据（volatile写入避免被编译器优化掉）
+    static void secure_zero(void *data, size_t length)
+    {
+        volatile uint8_t *p = static_cast<volatile uint8_t *>(data);
+        while (length--)
+        {
+            *p++ = 0;
+        }
+    }
+};
+
+/**
+ * @brief HKDF-SHA256（RFC 5869）
+ *
+ * 构造时执行Extract得到伪随机密钥PRK，并以PRK建立HMAC中间状态；
+ * 之后每次Expand派生子密钥时直接复用该状态，适合从同一共享密钥派生大量按分桶/会话区分的子密钥。
+ * 所有成员函数均为const，多个线程可同时使用同一对象。
+ */
+class HKDF_SHA256
+{
+public:
+    static constexpr size_t MAX_OUTPUT_SIZE = 255 * HMAC_SHA256::OUTPUT_SIZE; // RFC 5869规定的最大输出长度
+
+    /**
+     * @brief 构造函数：执行HKDF-Extract
+     * @param salt 盐值，可为空（等价于32个0字节）
+     * @param ikm 输入密钥材料（如DH共享密钥）
+     */
+    HKDF_SHA256(std::string_view salt, std::string_view ikm)
+        : m_prk(extract(salt, ikm))
+    {
+    }
+
+    /**
+     * @brief 执行HKDF-Extract：PRK = HMAC(salt, IKM)
+     */
+    static HMAC_SHA256 extract(std::string_view salt, std::string_view ikm)
+    {
+        std::array<uint8_t, 32> prk = HMAC_SHA256(salt).compute(ikm);
+        HMAC_SHA256 hmac(prk.data(), prk.size());
+        prk.fill(0);
+        return hmac;
+    }
+
+    /**
+     * @brief 执行HKDF-Expand，将派生结果写入output
+     * @param info 上下文信息（用于区分不同用途的子密钥，如分桶编号、会话编号）
+     * @param output 输出缓冲区，长度不超过 MAX_OUTPUT_SIZE
+     * @throws std::invalid_argument 输出长度超过上限时抛出异常
+     */
+    void expand(std::string_view info, std::span<uint8_t> output) const
+    {
+        if (output.size() > MAX_OUTPUT_SIZE)
+        {
+            throw std::invalid_argument("HKDF输出长度不能超过" + std::to_string(MAX_OUTPUT_SIZE) + "字节");
+        }
+
+        // T(i) = HMAC(PRK, T(i-1) || info || i)，T(0)为空
+        std::array<uint8_t, 32> block{};
+        size_t offset = 0;
+        for (uint8_t counter = 1; offset < output.size(); ++counter)
+        {
+            std::string_view previous(reinterpret_cast<const char *>(block.data()), counter == 1 ? 0 : block.size());
+            char counter_byte = static_cast<char>(counter);
+            block = m_prk.compute({previous, info, std::string_view(&counter_byte, 1)});
+
+            size_t n = std::min(block.size(), output.size() - offset);
+            std::memcpy(output.data() + offset, block.data(), n);
+            offset += n;
+        }
+        block.fill(0);
+    }
+
+    /**
+     * @brief 执行HKDF-Expand，返回length字节的子密钥
+     */
+    std::vector<uint8_t> expand(std::string_view info, size_t length) const
+    {
+        std::vector<uint8_t> output(length);
+        expand(info, output);
+        return output;
+    }
+
+    /**
+     * @brief 执行HKDF-Expand，以字节串形式返回子密钥（便于直接作为PRF_AES等的密钥）
+     */
+    std::string expand_string(std::string_view info, size_t length) const
+    {
+        std::string output(length, '\0');
+        expand(info, std::span<uint8_t>(reinterpret_cast<uint8_t *>(output.data()), output.size()));
+        return output;
+    }
+
+private:
+    HMAC_SHA256 m_prk; // 以PRK为密钥的HMAC中间状态
+};
+
+#endif // HMAC_SHA256_HPP
@@ -5,9 +5,33 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
-#include <sstream>
-#include <iomanip>
 #include <cstddef>
+#include <stdexcept>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include "../../CryptoTools/HexCodec.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SHA256_NI_AVAILABLE 1
+#define SHA256_NI_TARGET __attribute__((target("sha,sse4.1")))
+#define SHA256_AVX2_TARGET __attribute__((target("avx2")))
+#define SHA256_AVX512_TARGET __attribute__((target("avx512f")))
+#elif defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#define SHA256_ARMV8_AVAILABLE 1
+#if defined(__clang__)
+#define SHA256_ARMV8_TARGET __attribute__((target("sha2")))
+#else
+#define SHA256_ARMV8_TARGET __attribute__((target("+sha2")))
+#endif
+#endif
 
 /**
  * @brief SHA-256 哈希算法完整实现类
@@ -15,16 +39,42 @@
  * 此类整合了哈希算法的声明与实现，支持字节数组和字符串输入，
  * 输出 32 字节（256 位）哈希数组或 64 字符十六进制字符串，
  * 完全遵循 SHA-256 标准规范。
+ * 压缩函数在运行时按CPU特性选择：x86 SHA扩展指令、ARMv8 SHA2指令或可移植的标量实现。
  */
 class SHA256
 {
 public:
+    /**
+     * @brief 压缩函数后端
+     */
+    enum class Backend
+    {
+        Scalar, // 可移植的标量64轮循环
+        SHANI,  // x86 SHA扩展指令(SHA-NI)
+        ARMv8   // ARMv8 SHA2指令
+    };
+
     /**
      * @brief 构造函数
-     * 初始化哈希状态、数据缓冲区和计数器，委托 reset() 消除代码重复
+     * 使用当前CPU上最快的压缩函数后端，初始化哈希状态、数据缓冲区和计数器，委托 reset() 消除代码重复
+     */
+    SHA256() : SHA256(detect_backend())
+    {
+    }
+
+    /**
+     * @brief 构造函数（指定后端）
+     * @param backend 压缩函数后端
+     * @throws std::invalid_argument 当前CPU不支持指定后端时抛出异常
      */
-    SHA256()
+    explicit SHA256(Backend backend)
     {
+        if (!backend_supported(backend))
+        {
+            throw std::invalid_argument(std::string("当前CPU不支持SHA256后端: ") + backend_name(backend));
+        }
+        m_backend = backend;
+        m_compress = select_compress(backend);
         reset();
     }
 
@@ -49,22 +99,12 @@ public:
      * @brief 处理输入数据（字节数组形式）
      * @param data 输入数据的字节数组指针
      * @param length 输入数据长度（字节数）
-     * 注：每次调用会先重置状态，确保单次计算的独立性
+     * 注：每次调用会先重置状态，确保单次计算的独立性；需要分段输入时使用 update()
      */
     void input(const uint8_t *data, size_t length)
     {
         reset();
-        for (size_t i = 0; i < length; i++)
-        {
-            m_data[m_blocklen++] = data[i];
-            // 缓冲区满64字节（512位）时，触发块处理
-            if (m_blocklen == 64)
-            {
-                transform();
-                m_bitlen += 512;
-                m_blocklen = 0;
-            }
-        }
+        update(data, length);
     }
 
     /**
@@ -77,9 +117,64 @@ public:
         input(reinterpret_cast<const uint8_t *>(data.c_str()), data.size());
     }
 
+    /**
+     * @brief 追加输入数据（流式，字节数组形式）
+     * @param data 输入数据的字节数组指针
+     * @param length 输入数据长度（字节数）
+     * 多次调用的效果等同于一次输入全部数据的拼接，适合文件、网络流等无法整体缓存的输入。
+     * 先补齐缓冲区中不足64字节的部分，随后的完整分组直接从调用者的缓冲区批量压缩，
+     * 只有末尾不足64字节的数据被复制到缓冲区
+     */
+    void update(const uint8_t *data, size_t length)
+    {
+        // 1. 补齐上次调用遗留的不完整分组
+        if (m_blocklen > 0)
+        {
+            size_t fill = std::min<size_t>(64 - m_blocklen, length);
+            std::memcpy(m_data + m_blocklen, data, fill);
+            m_blocklen += static_cast<uint32_t>(fill);
+            data += fill;
+            length -= fill;
+            if (m_blocklen < 64)
+            {
+                return;
+            }
+            transform();
+            m_bitlen += 512;
+            m_blocklen = 0;
+        }
+
+        // 2. 完整分组直接从输入压缩
+        size_t full_blocks = length / 64;
+        if (full_blocks > 0)
+        {
+            m_compress(m_state, data, full_blocks);
+            m_bitlen += static_cast<uint64_t>(full_blocks) * 512;
+            data += full_blocks * 64;
+            length -= full_blocks * 64;
+        }
+
+        // 3. 剩余字节留在缓冲区
+        if (length > 0)
+        {
+            std::memcpy(m_data, data, length);
+            m_blocklen = static_cast<uint32_t>(length);
+        }
+    }
+
+    /**
+     * @brief 追加输入数据（流式，字符串形式，重载）
+     * @param data 输入的字符串
+     */
+    void update(std::string_view data)
+    {
+        update(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    }
+
     /**
      * @brief 完成哈希计算并返回哈希字节数组
      * @return std::array<uint8_t, 32> 32字节大端序哈希结果
+     * 注：完成后状态不再可用，继续计算前需调用 reset()
      */
     std::array<uint8_t, 32> digest()
     {
@@ -119,13 +214,7 @@ public:
      */
     static std::string toString_64(const std::array<uint8_t, 32> &digest)
     {
-        std::stringstream s;
-        s << std::setfill('0') << std::hex;
-        for (uint8_t byte : digest)
-        {
-            s << std::setw(2) << static_cast<unsigned int>(byte);
-        }
-        return s.str();
+        return CryptoTools::HexCodec::encode(digest);
     }
     /**
      * @brief 静态方法：哈希字节数组转十六进制字符串
@@ -151,12 +240,213 @@ public:
         return result;
     }
 
+    /**
+     * @brief 获取当前使用的压缩函数后端
+     */
+    Backend get_backend() const
+    {
+        return m_backend;
+    }
+
+    /**
+     * @brief 检测当前CPU上可用的最快后端（只检测一次）
+     */
+    static Backend detect_backend()
+    {
+        static const Backend detected = []
+        {
+            if (backend_supported(Backend::SHANI))
+            {
+                return Backend::SHANI;
+            }
+            if (backend_supported(Backend::ARMv8))
+            {
+                return Backend::ARMv8;
+            }
+            return Backend::Scalar;
+        }();
+        return detected;
+    }
+
+    /**
+     * @brief 判断指定后端在当前CPU上是否可用
+     */
+    static bool backend_supported(Backend backend)
+    {
+        switch (backend)
+        {
+        case Backend::Scalar:
+            return true;
+        case Backend::SHANI:
+#ifdef SHA256_NI_AVAILABLE
+        {
+            static const bool has_sha = []
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+            }();
+            return has_sha;
+        }
+#else
+            return false;
+#endif
+        case Backend::ARMv8:
+#if defined(SHA256_ARMV8_AVAILABLE) && defined(__APPLE__)
+            return true;
+#elif defined(SHA256_ARMV8_AVAILABLE)
+            return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+            return false;
+#endif
+        }
+        return false;
+    }
+
+    /**
+     * @brief 获取后端名称，便于日志输出
+     */
+    static const char *backend_name(Backend backend)
+    {
+        switch (backend)
+        {
+        case Backend::Scalar:
+            return "scalar";
+        case Backend::SHANI:
+            return "sha-ni";
+        case Backend::ARMv8:
+            return "armv8";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief 批量哈希的多缓冲区后端
+     */
+    enum class BatchBackend
+    {
+        Serial, // 逐条消息调用单缓冲区压缩函数(detect_backend()选择的后端)
+        AVX2,   // AVX2：8条消息各占一个32位通道，同时执行压缩函数
+        AVX512  // AVX-512：16条消息同时执行压缩函数
+    };
+
+    /**
+     * @brief 批量计算多条相互独立消息的哈希值
+     * @param messages 待哈希的消息
+     * @return 与messages一一对应的32字节哈希结果
+     * 面向大量短消息：多缓冲区后端每次压缩同时推进多条消息，
+     * 某条消息结束后其通道立即装入下一条消息，长短不一的消息也能保持通道满载。
+     */
+    static std::vector<std::array<uint8_t, 32>> hash_many(std::span<const std::string_view> messages)
+    {
+        return hash_many(messages, detect_batch_backend());
+    }
+
+    /**
+     * @brief 批量计算哈希值（指定多缓冲区后端）
+     * @throws std::invalid_argument 当前CPU不支持指定后端时抛出异常
+     */
+    static std::vector<std::array<uint8_t, 32>> hash_many(std::span<const std::string_view> messages, BatchBackend backend)
+    {
+        if (!batch_backend_supported(backend))
+        {
+            throw std::invalid_argument(std::string("当前CPU不支持SHA256批量后端: ") + batch_backend_name(backend));
+        }
+
+        std::vector<std::array<uint8_t, 32>> digests(messages.size());
+        switch (backend)
+        {
+#ifdef SHA256_NI_AVAILABLE
+        case BatchBackend::AVX2:
+            hash_lanes<8>(messages, digests.data(), compress_lanes_avx2);
+            break;
+        case BatchBackend::AVX512:
+            hash_lanes<16>(messages, digests.data(), compress_lanes_avx512);
+            break;
+#endif
+        default:
+        {
+            CompressFunc compress = select_compress(detect_backend());
+            for (size_t i = 0; i < messages.size(); ++i)
+            {
+                hash_single(compress, messages[i], digests[i].data());
+            }
+            break;
+        }
+        }
+        return digests;
+    }
+
+    /**
+     * @brief 检测当前CPU上可用的最快多缓冲区后端（只检测一次）
+     */
+    static BatchBackend detect_batch_backend()
+    {
+        static const BatchBackend detected = []
+        {
+            if (batch_backend_supported(BatchBackend::AVX512))
+            {
+                return BatchBackend::AVX512;
+            }
+            // 单条SHA-NI压缩快于8通道AVX2，仅在没有SHA扩展指令时使用AVX2
+            if (batch_backend_supported(BatchBackend::AVX2) && detect_backend() == Backend::Scalar)
+            {
+                return BatchBackend::AVX2;
+            }
+            return BatchBackend::Serial;
+        }();
+        return detected;
+    }
+
+    /**
+     * @brief 判断指定多缓冲区后端在当前CPU上是否可用
+     */
+    static bool batch_backend_supported(BatchBackend backend)
+    {
+        switch (backend)
+        {
+        case BatchBackend::Serial:
+            return true;
+#ifdef SHA256_NI_AVAILABLE
+        case BatchBackend::AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case BatchBackend::AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief 获取多缓冲区后端名称，便于日志输出
+     */
+    static const char *batch_backend_name(BatchBackend backend)
+    {
+        switch (backend)
+        {
+        case BatchBackend::Serial:
+            return "serial";
+        case BatchBackend::AVX2:
+            return "avx2x8";
+        case BatchBackend::AVX512:
+            return "avx512x16";
+        }
+        return "unknown";
+    }
+
 private:
+    // 压缩函数：依次处理blocks个64字节分组并更新state
+    using CompressFunc = void (*)(uint32_t *state, const uint8_t *data, size_t blocks);
+
     // ------------------------------ 私有成员变量 ------------------------------
     uint8_t m_data[64] = {0};  // 数据缓冲区（64字节 = SHA-256 块大小）
     uint32_t m_blocklen = 0;   // 缓冲区当前长度（0~63字节）
     uint64_t m_bitlen = 0;     // 已处理数据总长度（比特数）
     uint32_t m_state[8] = {0}; // 哈希状态寄存器（A~H 8个32位值）
+    Backend m_backend = Backend::Scalar;       // 压缩函数后端
+    CompressFunc m_compress = compress_scalar; // 与后端对应的压缩函数
 
     /**
      * @brief SHA-256 标准64个常量K
@@ -221,58 +511,525 @@ private:
     }
 
     /**
-     * @brief 核心变换：处理64字节数据块
-     * 实现SHA-256压缩函数，包括消息扩展和64轮迭代更新状态
+     * @brief 核心变换：处理缓冲区中的64字节数据块
+     * 按构造时选择的后端调用压缩函数
      */
     void transform()
     {
-        uint32_t m[64] = {0};    // 消息字数组（16个原始 + 48个扩展）
-        uint32_t state[8] = {0}; // 临时状态寄存器
+        m_compress(m_state, m_data, 1);
+    }
+
+    /**
+     * @brief 按后端选择压缩函数
+     */
+    static CompressFunc select_compress(Backend backend)
+    {
+        switch (backend)
+        {
+#ifdef SHA256_NI_AVAILABLE
+        case Backend::SHANI:
+            return compress_shani;
+#endif
+#ifdef SHA256_ARMV8_AVAILABLE
+        case Backend::ARMv8:
+            return compress_armv8;
+#endif
+        default:
+            return compress_scalar;
+        }
+    }
+
+    /**
+     * @brief 标量压缩函数（可移植的回退实现）
+     * 实现SHA-256压缩函数，包括消息扩展和64轮迭代更新状态
+     */
+    static void compress_scalar(uint32_t *hash_state, const uint8_t *data, size_t blocks)
+    {
+        for (; blocks > 0; --blocks, data += 64)
+        {
+            uint32_t m[64] = {0};    // 消息字数组（16个原始 + 48个扩展）
+            uint32_t state[8] = {0}; // 临时状态寄存器
+
+            // 1. 64字节分组转16个32位大端序消息字
+            for (uint8_t i = 0, j = 0; i < 16; i++, j += 4)
+            {
+                m[i] = (static_cast<uint32_t>(data[j]) << 24) |
+                       (static_cast<uint32_t>(data[j + 1]) << 16) |
+                       (static_cast<uint32_t>(data[j + 2]) << 8) |
+                       static_cast<uint32_t>(data[j + 3]);
+            }
+
+            // 2. 消息扩展：生成剩余48个消息字
+            for (uint8_t k = 16; k < 64; k++)
+            {
+                m[k] = sig1(m[k - 2]) + m[k - 7] + sig0(m[k - 15]) + m[k - 16];
+            }
+
+            // 3. 初始化临时状态
+            std::copy(hash_state, hash_state + 8, state);
+
+            // 4. 64轮压缩循环
+            for (uint8_t i = 0; i < 64; i++)
+            {
+                const uint32_t maj = majority(state[0], state[1], state[2]);
+                const uint32_t xorA = rotr(state[0], 2) ^ rotr(state[0], 13) ^ rotr(state[0], 22);
+                const uint32_t ch = choose(state[4], state[5], state[6]);
+                const uint32_t xorE = rotr(state[4], 6) ^ rotr(state[4], 11) ^ rotr(state[4], 25);
+                const uint32_t sum = m[i] + K[i] + state[7] + ch + xorE;
+
+                // 状态轮转更新
+                state[7] = state[6];
+                state[6] = state[5];
+                state[5] = state[4];
+                state[4] = state[3] + sum;
+                state[3] = state[2];
+                state[2] = state[1];
+                state[1] = state[0];
+                state[0] = xorA + maj + sum;
+            }
+
+            // 5. 临时状态累加到主状态
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                hash_state[i] += state[i];
+            }
+        }
+    }
+
+#ifdef SHA256_NI_AVAILABLE
+    /**
+     * @brief SHA-NI压缩函数
+     * sha256rnds2每条指令推进2轮，寄存器中的状态按ABEF/CDGH排列；
+     * sha256msg1/sha256msg2完成消息扩展，每组4个消息字在寄存器中滚动复用
+     */
+    SHA256_NI_TARGET static void compress_shani(uint32_t *hash_state, const uint8_t *data, size_t blocks)
+    {
+        const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // DCBA/HGFE -> ABEF/CDGH
+        __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash_state)), 0xB1);
+        __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash_state + 4)), 0x1B);
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+        for (; blocks > 0; --blocks, data += 64)
+        {
+            const __m128i abef_save = state0;
+            const __m128i cdgh_save = state1;
+
+            __m128i msg[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), byte_swap);
+            }
+
+#pragma GCC unroll 16
+            for (int i = 0; i < 16; ++i)
+            {
+                __m128i wk = _mm_add_epi32(msg[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i *>(K.data() + 4 * i)));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+
+                // W[t..t+3] -> W[t+16..t+19]
+                if (i < 12)
+                {
+                    __m128i next = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                    msg[i & 3] = _mm_sha256msg2_epu32(next, msg[(i + 3) & 3]);
+                }
+            }
+
+            state0 = _mm_add_epi32(state0, abef_save);
+            state1 = _mm_add_epi32(state1, cdgh_save);
+        }
+
+        // ABEF/CDGH -> DCBA/HGFE
+        tmp = _mm_shuffle_epi32(state0, 0x1B);
+        state1 = _mm_shuffle_epi32(state1, 0xB1);
+        state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+        state1 = _mm_alignr_epi8(state1, tmp, 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hash_state), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hash_state + 4), state1);
+    }
+#endif
+
+#ifdef SHA256_ARMV8_AVAILABLE
+    /**
+     * @brief ARMv8 SHA2压缩函数
+     * sha256h/sha256h2每组推进4轮，sha256su0/sha256su1完成消息扩展
+     */
+    SHA256_ARMV8_TARGET static void compress_armv8(uint32_t *hash_state, const uint8_t *data, size_t blocks)
+    {
+        uint32x4_t state0 = vld1q_u32(hash_state);
+        uint32x4_t state1 = vld1q_u32(hash_state + 4);
+
+        for (; blocks > 0; --blocks, data += 64)
+        {
+            const uint32x4_t abcd_save = state0;
+            const uint32x4_t efgh_save = state1;
+
+            uint32x4_t msg[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+            }
+
+#pragma GCC unroll 16
+            for (int i = 0; i < 16; ++i)
+            {
+                uint32x4_t wk = vaddq_u32(msg[i & 3], vld1q_u32(K.data() + 4 * i));
+                uint32x4_t abcd = state0;
+                state0 = vsha256hq_u32(state0, state1, wk);
+                state1 = vsha256h2q_u32(state1, abcd, wk);
+
+                // W[t..t+3] -> W[t+16..t+19]
+                if (i < 12)
+                {
+                    msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]), msg[(i + 2) & 3], msg[(i + 3) & 3]);
+                }
+            }
+
+            state0 = vaddq_u32(state0, abcd_save);
+            state1 = vaddq_u32(state1, efgh_save);
+        }
+
+        vst1q_u32(hash_state, state0);
+        vst1q_u32(hash_state + 4, state1);
+    }
+#endif
+
+    /**
+     * @brief 构造消息末尾的填充分组
+     * @param data 完整消息
+     * @param length 消息长度（字节）
+     * @param tail 输出的填充分组，至少128字节
+     * @return 填充分组数（1或2）
+     * 消息中完整的64字节分组直接从原数据读取，只有剩余字节与填充需要复制
+     */
+    static size_t build_tail(const uint8_t *data, size_t length, uint8_t *tail)
+    {
+        size_t remainder = length % 64;
+        size_t tail_blocks = remainder < 56 ? 1 : 2;
+        std::memset(tail, 0, 64 * tail_blocks);
+        if (remainder > 0)
+        {
+            std::memcpy(tail, data + length - remainder, remainder);
+        }
+        tail[remainder] = 0x80;
+
+        uint64_t bitlen = static_cast<uint64_t>(length) * 8;
+        uint8_t *end = tail + 64 * tail_blocks;
+        for (int i = 1; i <= 8; ++i)
+        {
+            end[-i] = static_cast<uint8_t>(bitlen >> (8 * (i - 1)));
+        }
+        return tail_blocks;
+    }
+
+    /**
+     * @brief 将状态寄存器按大端序写出为32字节哈希结果
+     */
+    static void store_digest(const uint32_t *hash_state, uint8_t *digest)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            digest[4 * i] = static_cast<uint8_t>(hash_state[i] >> 24);
+            digest[4 * i + 1] = static_cast<uint8_t>(hash_state[i] >> 16);
+            digest[4 * i + 2] = static_cast<uint8_t>(hash_state[i] >> 8);
+            digest[4 * i + 3] = static_cast<uint8_t>(hash_state[i]);
+        }
+    }
+
+    /**
+     * @brief 用单缓冲区压缩函数计算一条消息的哈希值
+     */
+    static void hash_single(CompressFunc compress, std::string_view message, uint8_t *digest)
+    {
+        static constexpr uint32_t INITIAL_STATE[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        uint32_t hash_state[8];
+        std::copy(INITIAL_STATE, INITIAL_STATE + 8, hash_state);
+
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(message.data());
+        size_t full_blocks = message.size() / 64;
+        if (full_blocks > 0)
+        {
+            compress(hash_state, data, full_blocks);
+        }
+        uint8_t tail[128];
+        compress(hash_state, tail, build_tail(data, message.size(), tail));
+        store_digest(hash_state, digest);
+    }
+
+    /**
+     * @brief 多缓冲区调度：LANES条消息各占一个通道，每次同时压缩各通道的下一个分组
+     * @param messages 待哈希的消息
+     * @param digests 输出的哈希结果
+     * @param compress_lanes 多通道压缩函数，state与words均按[字下标][通道]排列
+     * 某通道的消息处理完后立即装入下一条消息；没有新消息且满载率不足一半时，
+     * 剩余消息改用单缓冲区压缩函数完成，避免空转通道拖慢长消息收尾
+     */
+    template <size_t LANES>
+    static void hash_lanes(std::span<const std::string_view> messages, std::array<uint8_t, 32> *digests,
+                           void (*compress_lanes)(uint32_t *state, const uint32_t *words))
+    {
+        struct Lane
+        {
+            size_t index;       // 消息下标
+            const uint8_t *data; // 消息数据
+            size_t full_blocks; // 直接从消息读取的完整分组数
+            size_t total_blocks; // 含填充的总分组数
+            size_t block;       // 下一个待处理的分组
+            alignas(16) uint8_t tail[128]; // 填充分组
+        };
+
+        static constexpr uint32_t INITIAL_STATE[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
 
-        // 1. 64字节缓冲区转16个32位大端序消息字
-        for (uint8_t i = 0, j = 0; i < 16; i++, j += 4)
+        alignas(64) uint32_t state[8 * LANES];
+        alignas(64) uint32_t words[16 * LANES] = {0};
+        Lane lanes[LANES];
+        bool active[LANES] = {false};
+        size_t active_count = 0;
+        size_t next = 0;
+
+        // 把下一条消息装入通道lane并重置该通道的状态
+        auto assign = [&](size_t lane)
         {
-            m[i] = (static_cast<uint32_t>(m_data[j]) << 24) |
-                   (static_cast<uint32_t>(m_data[j + 1]) << 16) |
-                   (static_cast<uint32_t>(m_data[j + 2]) << 8) |
-                   static_cast<uint32_t>(m_data[j + 3]);
+            Lane &l = lanes[lane];
+            std::string_view message = messages[next];
+            l.index = next++;
+            l.data = reinterpret_cast<const uint8_t *>(message.data());
+            l.full_blocks = message.size() / 64;
+            l.total_blocks = l.full_blocks + build_tail(l.data, message.size(), l.tail);
+            l.block = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                state[i * LANES + lane] = INITIAL_STATE[i];
+            }
+            if (!active[lane])
+            {
+                active[lane] = true;
+                ++active_count;
+            }
+        };
+
+        for (size_t lane = 0; lane < LANES && next < messages.size(); ++lane)
+        {
+            assign(lane);
         }
 
-        // 2. 消息扩展：生成剩余48个消息字
-        for (uint8_t k = 16; k < 64; k++)
+        while (active_count > 0)
         {
-            m[k] = sig1(m[k - 2]) + m[k - 7] + sig0(m[k - 15]) + m[k - 16];
+            if (next == messages.size() && active_count * 2 < LANES)
+            {
+                break;
+            }
+
+            // 转置：各通道当前分组的第i个大端序字写入words[i][lane]
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                if (!active[lane])
+                {
+                    continue;
+                }
+                const Lane &l = lanes[lane];
+                const uint8_t *block = l.block < l.full_blocks ? l.data + 64 * l.block : l.tail + 64 * (l.block - l.full_blocks);
+                for (int i = 0; i < 16; ++i)
+                {
+                    uint32_t word;
+                    std::memcpy(&word, block + 4 * i, 4);
+                    words[i * LANES + lane] = __builtin_bswap32(word);
+                }
+            }
+
+            compress_lanes(state, words);
+
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                if (!active[lane] || ++lanes[lane].block < lanes[lane].total_blocks)
+                {
+                    continue;
+                }
+                uint32_t hash_state[8];
+                for (int i = 0; i < 8; ++i)
+                {
+                    hash_state[i] = state[i * LANES + lane];
+                }
+                store_digest(hash_state, digests[lanes[lane].index].data());
+                if (next < messages.size())
+                {
+                    assign(lane);
+                }
+                else
+                {
+                    active[lane] = false;
+                    --active_count;
+                }
+            }
+        }
+
+        // 收尾：剩余通道改用单缓冲区压缩函数
+        CompressFunc compress = select_compress(detect_backend());
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            if (!active[lane])
+            {
+                continue;
+            }
+            const Lane &l = lanes[lane];
+            uint32_t hash_state[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                hash_state[i] = state[i * LANES + lane];
+            }
+            if (l.block < l.full_blocks)
+            {
+                compress(hash_state, l.data + 64 * l.block, l.full_blocks - l.block);
+            }
+            size_t tail_start = l.block > l.full_blocks ? l.block - l.full_blocks : 0;
+            compress(hash_state, l.tail + 64 * tail_start, l.total_blocks - l.full_blocks - tail_start);
+            store_digest(hash_state, digests[l.index].data());
         }
+    }
 
-        // 3. 初始化临时状态
-        std::copy(m_state, m_state + 8, state);
+#ifdef SHA256_NI_AVAILABLE
+    /**
+     * @brief AVX2没有32位循环移位指令，用两次移位与或运算实现
+     */
+    SHA256_AVX2_TARGET static inline __m256i rotr_avx2(__m256i x, int n)
+    {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
 
-        // 4. 64轮压缩循环
-        for (uint8_t i = 0; i < 64; i++)
+    /**
+     * @brief AVX2多通道压缩函数：8条消息各占一个32位通道
+     * @param state 状态寄存器，state[i * 8 + lane]为第lane条消息的第i个状态字
+     * @param words 消息字，words[i * 8 + lane]为第lane条消息当前分组的第i个字
+     */
+    SHA256_AVX2_TARGET static void compress_lanes_avx2(uint32_t *state, const uint32_t *words)
+    {
+        __m256i s[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            s[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(state + 8 * i));
+        }
+        __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        __m256i w[16];
+
+#pragma GCC unroll 64
+        for (int t = 0; t < 64; ++t)
+        {
+            if (t < 16)
+            {
+                w[t] = _mm256_load_si256(reinterpret_cast<const __m256i *>(words + 8 * t));
+            }
+            else
+            {
+                __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+                __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2(w15, 7), rotr_avx2(w15, 18)), _mm256_srli_epi32(w15, 3));
+                __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2(w2, 17), rotr_avx2(w2, 19)), _mm256_srli_epi32(w2, 10));
+                w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+            }
+
+            __m256i sum1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2(e, 6), rotr_avx2(e, 11)), rotr_avx2(e, 25));
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sum1), _mm256_add_epi32(ch, _mm256_add_epi32(w[t & 15], _mm256_set1_epi32(static_cast<int>(K[t])))));
+            __m256i sum0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2(a, 2), rotr_avx2(a, 13)), rotr_avx2(a, 22));
+            __m256i maj = _mm256_or_si256(_mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+            __m256i t2 = _mm256_add_epi32(sum0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+
+        const __m256i out[8] = {a, b, c, d, e, f, g, h};
+        for (int i = 0; i < 8; ++i)
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(state + 8 * i), _mm256_add_epi32(s[i], out[i]));
+        }
+    }
+
+    /**
+     * @brief AVX-512循环右移与逻辑右移
+     * 使用全1掩码的maskz形式，避免GCC内部_mm512_undefined_epi32引发的未初始化告警；
+     * 移位位数必须是立即数，因此作为模板参数传入，未开启优化时同样能编译
+     */
+    template <int N>
+    SHA256_AVX512_TARGET static inline __m512i ror_avx512(__m512i x)
+    {
+        return _mm512_maskz_ror_epi32(0xFFFF, x, N);
+    }
+
+    template <unsigned int N>
+    SHA256_AVX512_TARGET static inline __m512i srli_avx512(__m512i x)
+    {
+        return _mm512_maskz_srli_epi32(0xFFFF, x, N);
+    }
+
+    /**
+     * @brief AVX-512多通道压缩函数：16条消息各占一个32位通道
+     * 循环移位使用vprord，选择/多数/三路异或使用vpternlogd各一条指令完成
+     * @param state 状态寄存器，state[i * 16 + lane]为第lane条消息的第i个状态字
+     * @param words 消息字，words[i * 16 + lane]为第lane条消息当前分组的第i个字
+     */
+    SHA256_AVX512_TARGET static void compress_lanes_avx512(uint32_t *state, const uint32_t *words)
+    {
+        __m512i s[8];
+        for (int i = 0; i < 8; ++i)
         {
-            const uint32_t maj = majority(state[0], state[1], state[2]);
-            const uint32_t xorA = rotr(state[0], 2) ^ rotr(state[0], 13) ^ rotr(state[0], 22);
-            const uint32_t ch = choose(state[4], state[5], state[6]);
-            const uint32_t xorE = rotr(state[4], 6) ^ rotr(state[4], 11) ^ rotr(state[4], 25);
-            const uint32_t sum = m[i] + K[i] + state[7] + ch + xorE;
+            s[i] = _mm512_load_si512(state + 16 * i);
+        }
+        __m512i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        __m512i w[16];
+
+#pragma GCC unroll 64
+        for (int t = 0; t < 64; ++t)
+        {
+            if (t < 16)
+            {
+                w[t] = _mm512_load_si512(words + 16 * t);
+            }
+            else
+            {
+                __m512i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+                __m512i s0 = _mm512_ternarylogic_epi32(ror_avx512<7>(w15), ror_avx512<18>(w15), srli_avx512<3>(w15), 0x96);
+                __m512i s1 = _mm512_ternarylogic_epi32(ror_avx512<17>(w2), ror_avx512<19>(w2), srli_avx512<10>(w2), 0x96);
+                w[t & 15] = _mm512_add_epi32(_mm512_add_epi32(w[t & 15], s0), _mm512_add_epi32(w[(t - 7) & 15], s1));
+            }
+
+            __m512i sum1 = _mm512_ternarylogic_epi32(ror_avx512<6>(e), ror_avx512<11>(e), ror_avx512<25>(e), 0x96);
+            __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+            __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(h, sum1), _mm512_add_epi32(ch, _mm512_add_epi32(w[t & 15], _mm512_set1_epi32(static_cast<int>(K[t])))));
+            __m512i sum0 = _mm512_ternarylogic_epi32(ror_avx512<2>(a), ror_avx512<13>(a), ror_avx512<22>(a), 0x96);
+            __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+            __m512i t2 = _mm512_add_epi32(sum0, maj);
 
-            // 状态轮转更新
-            state[7] = state[6];
-            state[6] = state[5];
-            state[5] = state[4];
-            state[4] = state[3] + sum;
-            state[3] = state[2];
-            state[2] = state[1];
-            state[1] = state[0];
-            state[0] = xorA + maj + sum;
+            h = g;
+            g = f;
+            f = e;
+            e = _mm512_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm512_add_epi32(t1, t2);
         }
 
-        // 5. 临时状态累加到主状态
-        for (uint8_t i = 0; i < 8; i++)
+        const __m512i out[8] = {a, b, c, d, e, f, g, h};
+        for (int i = 0; i < 8; ++i)
         {
-            m_state[i] += state[i];
+            _mm512_store_si512(state + 16 * i, _mm512_add_epi32(s[i], out[i]));
         }
     }
+#endif
 
     /**
      * @brief 数据填充：满足512位块对齐要求
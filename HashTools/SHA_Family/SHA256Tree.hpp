@@ -0,0 +1,249 @@
+#ifndef SHA256_TREE_HPP
+#define SHA256_TREE_HPP
+
+#include "SHA256.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief 基于SHA-256的并行Merkle树哈希（面向大文件指纹）
+ *
+ * 文件通过mmap映射后按固定大小切分为数据块，各数据块在多个线程上并行计算叶子哈希，
+ * 再逐层两两合并为根哈希。为区分叶子与内部节点（防止第二原像攻击），采用与RFC 6962相同的前缀：
+ *   叶子节点  leaf_i = SHA256(0x00 || chunk_i)
+ *   内部节点  node   = SHA256(0x01 || left || right)
+ * 某层节点数为奇数时，最后一个节点直接提升到上一层。空输入视为一个空数据块。
+ *
+ * 注意：树哈希的结果与普通SHA-256不同，且取决于数据块大小，只有使用相同chunk_size计算的根哈希才可比较。
+ * 需要与sha256sum等工具兼容时使用 hash_file_sequential()。
+ */
+class SHA256Tree
+{
+public:
+    // 默认数据块大小：1 MiB，足以摊薄线程调度开销，同时让中等大小的文件也能分给多个线程
+    static constexpr size_t DEFAULT_CHUNK_SIZE = size_t(1) << 20;
+
+    /**
+     * @brief 计算文件的Merkle树根哈希
+     * @param path 文件路径
+     * @param chunk_size 数据块大小（字节），必须大于0
+     * @param threads 线程数，为0时使用硬件并发数
+     * @return 32字节根哈希
+     * @throws std::runtime_error 文件无法打开或映射时抛出异常
+     * @throws std::invalid_argument chunk_size为0时抛出异常
+     */
+    static std::array<uint8_t, 32> hash_file(const std::string &path, size_t chunk_size = DEFAULT_CHUNK_SIZE, unsigned threads = 0)
+    {
+        MappedFile file(path);
+        return hash_buffer(file.data(), file.size(), chunk_size, threads);
+    }
+
+    /**
+     * @brief 计算内存缓冲区的Merkle树根哈希（与 hash_file() 对相同内容的结果一致）
+     * @param data 数据指针
+     * @param length 数据长度（字节）
+     * @param chunk_size 数据块大小（字节），必须大于0
+     * @param threads 线程数，为0时使用硬件并发数
+     * @return 32字节根哈希
+     */
+    static std::array<uint8_t, 32> hash_buffer(const uint8_t *data, size_t length, size_t chunk_size = DEFAULT_CHUNK_SIZE, unsigned threads = 0)
+    {
+        if (chunk_size == 0)
+        {
+            throw std::invalid_argument("SHA256Tree数据块大小必须大于0");
+        }
+
+        size_t leaf_count = length == 0 ? 1 : (length - 1) / chunk_size + 1;
+        std::vector<std::array<uint8_t, 32>> leaves(leaf_count);
+
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = static_cast<unsigned>(std::min<size_t>(threads, leaf_count));
+
+        // 各线程从共享计数器领取数据块，数据块大小相同时负载自然均衡
+        std::atomic<size_t> next{0};
+        std::exception_ptr error;
+        std::atomic<bool> failed{false};
+        auto worker = [&]
+        {
+            try
+            {
+                for (size_t i = next.fetch_add(1); i < leaf_count && !failed.load(std::memory_order_relaxed); i = next.fetch_add(1))
+                {
+                    size_t offset = i * chunk_size;
+                    size_t size = std::min(chunk_size, length - std::min(offset, length));
+                    leaves[i] = hash_leaf(data + offset, size);
+                }
+            }
+            catch (...)
+            {
+                if (!failed.exchange(true))
+                {
+                    error = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            try
+            {
+                pool.emplace_back(worker);
+            }
+            catch (const std::system_error &)
+            {
+                // 无法再创建线程时，剩余数据块由已启动的线程和当前线程领取
+                break;
+            }
+        }
+        worker();
+        for (auto &thread : pool)
+        {
+            thread.join();
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+
+        return merkle_root(std::move(leaves));
+    }
+
+    /**
+     * @brief 计算文件的普通SHA-256哈希（兼容模式，与sha256sum结果一致）
+     * @param path 文件路径
+     * @return 32字节哈希
+     * @throws std::runtime_error 文件无法打开或映射时抛出异常
+     */
+    static std::array<uint8_t, 32> hash_file_sequential(const std::string &path)
+    {
+        MappedFile file(path);
+        SHA256 sha256;
+        sha256.update(file.data(), file.size());
+        return sha256.digest();
+    }
+
+private:
+    /**
+     * @brief 只读映射整个文件的RAII封装
+     * 空文件不映射，data()返回空指针、size()为0
+     */
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string &path)
+        {
+            m_fd = ::open(path.c_str(), O_RDONLY);
+            if (m_fd < 0)
+            {
+                throw std::runtime_error("无法打开文件 " + path + ": " + std::strerror(errno));
+            }
+            struct stat st;
+            if (::fstat(m_fd, &st) != 0)
+            {
+                int err = errno;
+                ::close(m_fd);
+                throw std::runtime_error("无法获取文件大小 " + path + ": " + std::strerror(err));
+            }
+            m_size = static_cast<size_t>(st.st_size);
+            if (m_size > 0)
+            {
+                void *addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+                if (addr == MAP_FAILED)
+                {
+                    int err = errno;
+                    ::close(m_fd);
+                    throw std::runtime_error("无法映射文件 " + path + ": " + std::strerror(err));
+                }
+                m_data = static_cast<const uint8_t *>(addr);
+                // 顺序读取提示：内核加大预读窗口
+                ::madvise(addr, m_size, MADV_SEQUENTIAL);
+            }
+        }
+
+        ~MappedFile()
+        {
+            if (m_data != nullptr)
+            {
+                ::munmap(const_cast<uint8_t *>(m_data), m_size);
+            }
+            ::close(m_fd);
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const uint8_t *data() const { return m_data; }
+        size_t size() const { return m_size; }
+
+    private:
+        int m_fd = -1;
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+    /**
+     * @brief 计算叶子哈希 SHA256(0x00 || chunk)
+     */
+    static std::array<uint8_t, 32> hash_leaf(const uint8_t *data, size_t length)
+    {
+        static const uint8_t LEAF_PREFIX = 0x00;
+        SHA256 sha256;
+        sha256.update(&LEAF_PREFIX, 1);
+        sha256.update(data, length);
+        return sha256.digest();
+    }
+
+    /**
+     * @brief 逐层合并节点直到只剩根节点
+     * 每层的内部节点相互独立，整层交给 SHA256::hash_many 批量计算
+     */
+    static std::array<uint8_t, 32> merkle_root(std::vector<std::array<uint8_t, 32>> level)
+    {
+        std::string nodes;
+        std::vector<std::string_view> messages;
+        while (level.size() > 1)
+        {
+            size_t pairs = level.size() / 2;
+            nodes.assign(pairs * 65, '\0');
+            messages.clear();
+            for (size_t i = 0; i < pairs; ++i)
+            {
+                char *node = nodes.data() + 65 * i;
+                node[0] = 0x01;
+                std::memcpy(node + 1, level[2 * i].data(), 32);
+                std::memcpy(node + 33, level[2 * i + 1].data(), 32);
+                messages.emplace_back(node, 65);
+            }
+
+            std::vector<std::array<uint8_t, 32>> parents = SHA256::hash_many(messages);
+            if (level.size() % 2 == 1)
+            {
+                parents.push_back(level.back());
+            }
+            level = std::move(parents);
+        }
+        return level.front();
+    }
+};
+
+#endif // SHA256_TREE_HPP
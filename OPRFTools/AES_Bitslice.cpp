@@ -0,0 +1,680 @@
+#include "AES_Bitslice.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace OPRFTools
+{
+    namespace AES_Bitslice
+    {
+        // 小端序读取32位字
+        static inline uint32_t load32le(const uint8_t *p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        // 小端序写入32位字
+        static inline void store32le(uint8_t *p, uint32_t x)
+        {
+            p[0] = static_cast<uint8_t>(x);
+            p[1] = static_cast<uint8_t>(x >> 8);
+            p[2] = static_cast<uint8_t>(x >> 16);
+            p[3] = static_cast<uint8_t>(x >> 24);
+        }
+
+        /**
+         * @brief 位切片S盒：对q[0..7]承载的全部字节并行计算AES S盒
+         *
+         * 采用Boyar-Peralta的113门电路(顶层线性变换、GF(2^4)求逆的非线性部分、底层线性变换)，
+         * q[7]为各字节的最低位，q[0]为最高位。
+         *
+         * @param q 8个64位位切片字
+         */
+        static inline void sbox(uint64_t *q)
+        {
+            uint64_t x0, x1, x2, x3, x4, x5, x6, x7;
+            uint64_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+            uint64_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+            uint64_t y20, y21;
+            uint64_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+            uint64_t z10, z11, z12, z13, z14, z15, z16, z17;
+            uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+            uint64_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+            uint64_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+            uint64_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+            uint64_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+            uint64_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+            uint64_t t60, t61, t62, t63, t64, t65, t66, t67;
+            uint64_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+            x0 = q[7];
+            x1 = q[6];
+            x2 = q[5];
+            x3 = q[4];
+            x4 = q[3];
+            x5 = q[2];
+            x6 = q[1];
+            x7 = q[0];
+
+            // 顶层线性变换
+            y14 = x3 ^ x5;
+            y13 = x0 ^ x6;
+            y9 = x0 ^ x3;
+            y8 = x0 ^ x5;
+            t0 = x1 ^ x2;
+            y1 = t0 ^ x7;
+            y4 = y1 ^ x3;
+            y12 = y13 ^ y14;
+            y2 = y1 ^ x0;
+            y5 = y1 ^ x6;
+            y3 = y5 ^ y8;
+            t1 = x4 ^ y12;
+            y15 = t1 ^ x5;
+            y20 = t1 ^ x1;
+            y6 = y15 ^ x7;
+            y10 = y15 ^ t0;
+            y11 = y20 ^ y9;
+            y7 = x7 ^ y11;
+            y17 = y10 ^ y11;
+            y19 = y10 ^ y8;
+            y16 = t0 ^ y11;
+            y21 = y13 ^ y16;
+            y18 = x0 ^ y16;
+
+            // 非线性部分
+            t2 = y12 & y15;
+            t3 = y3 & y6;
+            t4 = t3 ^ t2;
+            t5 = y4 & x7;
+            t6 = t5 ^ t2;
+            t7 = y13 & y16;
+            t8 = y5 & y1;
+            t9 = t8 ^ t7;
+            t10 = y2 & y7;
+            t11 = t10 ^ t7;
+            t12 = y9 & y11;
+            t13 = y14 & y17;
+            t14 = t13 ^ t12;
+            t15 = y8 & y10;
+            t16 = t15 ^ t12;
+            t17 = t4 ^ t14;
+            t18 = t6 ^ t16;
+            t19 = t9 ^ t14;
+            t20 = t11 ^ t16;
+            t21 = t17 ^ y20;
+            t22 = t18 ^ y19;
+            t23 = t19 ^ y21;
+            t24 = t20 ^ y18;
+
+            t25 = t21 ^ t22;
+            t26 = t21 & t23;
+            t27 = t24 ^ t26;
+            t28 = t25 & t27;
+            t29 = t28 ^ t22;
+            t30 = t23 ^ t24;
+            t31 = t22 ^ t26;
+            t32 = t31 & t30;
+            t33 = t32 ^ t24;
+            t34 = t23 ^ t33;
+            t35 = t27 ^ t33;
+            t36 = t24 & t35;
+            t37 = t36 ^ t34;
+            t38 = t27 ^ t36;
+            t39 = t29 & t38;
+            t40 = t25 ^ t39;
+
+            t41 = t40 ^ t37;
+            t42 = t29 ^ t33;
+            t43 = t29 ^ t40;
+            t44 = t33 ^ t37;
+            t45 = t42 ^ t41;
+            z0 = t44 & y15;
+            z1 = t37 & y6;
+            z2 = t33 & x7;
+            z3 = t43 & y16;
+            z4 = t40 & y1;
+            z5 = t29 & y7;
+            z6 = t42 & y11;
+            z7 = t45 & y17;
+            z8 = t41 & y10;
+            z9 = t44 & y12;
+            z10 = t37 & y3;
+            z11 = t33 & y4;
+            z12 = t43 & y13;
+            z13 = t40 & y5;
+            z14 = t29 & y2;
+            z15 = t42 & y9;
+            z16 = t45 & y14;
+            z17 = t41 & y8;
+
+            // 底层线性变换
+            t46 = z15 ^ z16;
+            t47 = z10 ^ z11;
+            t48 = z5 ^ z13;
+            t49 = z9 ^ z10;
+            t50 = z2 ^ z12;
+            t51 = z2 ^ z5;
+            t52 = z7 ^ z8;
+            t53 = z0 ^ z3;
+            t54 = z6 ^ z7;
+            t55 = z16 ^ z17;
+            t56 = z12 ^ t48;
+            t57 = t50 ^ t53;
+            t58 = z4 ^ t46;
+            t59 = z3 ^ t54;
+            t60 = t46 ^ t57;
+            t61 = z14 ^ t57;
+            t62 = t52 ^ t58;
+            t63 = t49 ^ t58;
+            t64 = z4 ^ t59;
+            t65 = t61 ^ t62;
+            t66 = z1 ^ t63;
+            s0 = t59 ^ t63;
+            s6 = t56 ^ ~t62;
+            s7 = t48 ^ ~t60;
+            t67 = t64 ^ t65;
+            s3 = t53 ^ t66;
+            s4 = t51 ^ t66;
+            s5 = t47 ^ t65;
+            s1 = t64 ^ ~s3;
+            s2 = t55 ^ ~t67;
+
+            q[7] = s0;
+            q[6] = s1;
+            q[5] = s2;
+            q[4] = s3;
+            q[3] = s4;
+            q[2] = s5;
+            q[1] = s6;
+            q[0] = s7;
+        }
+
+        /**
+         * @brief 位矩阵转置：在“字节交织”表示与“位切片”表示之间互相转换(自逆)
+         * @param q 8个64位字
+         */
+        static inline void ortho(uint64_t *q)
+        {
+            auto swapn = [](uint64_t cl, uint64_t ch, int s, uint64_t &x, uint64_t &y)
+            {
+                uint64_t a = x;
+                uint64_t b = y;
+                x = (a & cl) | ((b & cl) << s);
+                y = ((a & ch) >> s) | (b & ch);
+            };
+            auto swap2 = [&](uint64_t &x, uint64_t &y)
+            { swapn(0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1, x, y); };
+            auto swap4 = [&](uint64_t &x, uint64_t &y)
+            { swapn(0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2, x, y); };
+            auto swap8 = [&](uint64_t &x, uint64_t &y)
+            { swapn(0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4, x, y); };
+
+            swap2(q[0], q[1]);
+            swap2(q[2], q[3]);
+            swap2(q[4], q[5]);
+            swap2(q[6], q[7]);
+
+            swap4(q[0], q[2]);
+            swap4(q[1], q[3]);
+            swap4(q[4], q[6]);
+            swap4(q[5], q[7]);
+
+            swap8(q[0], q[4]);
+            swap8(q[1], q[5]);
+            swap8(q[2], q[6]);
+            swap8(q[3], q[7]);
+        }
+
+        /**
+         * @brief 将一个分组的4个32位字交织到两个64位字中
+         * @param q0 输出：承载第0、2个字
+         * @param q1 输出：承载第1、3个字
+         * @param w 分组的4个小端序32位字
+         */
+        static inline void interleave_in(uint64_t &q0, uint64_t &q1, const uint32_t *w)
+        {
+            uint64_t x0 = w[0];
+            uint64_t x1 = w[1];
+            uint64_t x2 = w[2];
+            uint64_t x3 = w[3];
+            x0 |= (x0 << 16);
+            x1 |= (x1 << 16);
+            x2 |= (x2 << 16);
+            x3 |= (x3 << 16);
+            x0 &= 0x0000FFFF0000FFFFULL;
+            x1 &= 0x0000FFFF0000FFFFULL;
+            x2 &= 0x0000FFFF0000FFFFULL;
+            x3 &= 0x0000FFFF0000FFFFULL;
+            x0 |= (x0 << 8);
+            x1 |= (x1 << 8);
+            x2 |= (x2 << 8);
+            x3 |= (x3 << 8);
+            x0 &= 0x00FF00FF00FF00FFULL;
+            x1 &= 0x00FF00FF00FF00FFULL;
+            x2 &= 0x00FF00FF00FF00FFULL;
+            x3 &= 0x00FF00FF00FF00FFULL;
+            q0 = x0 | (x2 << 8);
+            q1 = x1 | (x3 << 8);
+        }
+
+        /**
+         * @brief interleave_in的逆变换
+         * @param w 输出：分组的4个小端序32位字
+         * @param q0 承载第0、2个字
+         * @param q1 承载第1、3个字
+         */
+        static inline void interleave_out(uint32_t *w, uint64_t q0, uint64_t q1)
+        {
+            uint64_t x0 = q0 & 0x00FF00FF00FF00FFULL;
+            uint64_t x1 = q1 & 0x00FF00FF00FF00FFULL;
+            uint64_t x2 = (q0 >> 8) & 0x00FF00FF00FF00FFULL;
+            uint64_t x3 = (q1 >> 8) & 0x00FF00FF00FF00FFULL;
+            x0 |= (x0 >> 8);
+            x1 |= (x1 >> 8);
+            x2 |= (x2 >> 8);
+            x3 |= (x3 >> 8);
+            x0 &= 0x0000FFFF0000FFFFULL;
+            x1 &= 0x0000FFFF0000FFFFULL;
+            x2 &= 0x0000FFFF0000FFFFULL;
+            x3 &= 0x0000FFFF0000FFFFULL;
+            w[0] = static_cast<uint32_t>(x0) | static_cast<uint32_t>(x0 >> 16);
+            w[1] = static_cast<uint32_t>(x1) | static_cast<uint32_t>(x1 >> 16);
+            w[2] = static_cast<uint32_t>(x2) | static_cast<uint32_t>(x2 >> 16);
+            w[3] = static_cast<uint32_t>(x3) | static_cast<uint32_t>(x3 >> 16);
+        }
+
+        /**
+         * @brief 将4个分组载入位切片表示
+         * @param q 输出的8个64位字
+         * @param blocks 4个16字节分组
+         */
+        static inline void load4(uint64_t *q, const uint8_t *blocks)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                uint32_t w[4];
+                for (int j = 0; j < 4; ++j)
+                {
+                    w[j] = load32le(blocks + 16 * i + 4 * j);
+                }
+                interleave_in(q[i], q[i + 4], w);
+            }
+            ortho(q);
+        }
+
+        /**
+         * @brief 将位切片表示写回为4个分组
+         * @param blocks 输出的4个16字节分组
+         * @param q 8个64位字(函数内部会被修改)
+         */
+        static inline void store4(uint8_t *blocks, uint64_t *q)
+        {
+            ortho(q);
+            for (int i = 0; i < 4; ++i)
+            {
+                uint32_t w[4];
+                interleave_out(w, q[i], q[i + 4]);
+                for (int j = 0; j < 4; ++j)
+                {
+                    store32le(blocks + 16 * i + 4 * j, w[j]);
+                }
+            }
+        }
+
+        // 轮密钥加
+        static inline void add_round_key(uint64_t *q, const uint64_t *sk)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                q[i] ^= sk[i];
+            }
+        }
+
+        // 行移位(位切片表示下为64位字内的固定位置换)
+        static inline void shift_rows(uint64_t *q)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                uint64_t x = q[i];
+                q[i] = (x & 0x000000000000FFFFULL) |
+                       ((x & 0x00000000FFF00000ULL) >> 4) |
+                       ((x & 0x00000000000F0000ULL) << 12) |
+                       ((x & 0x0000FF0000000000ULL) >> 8) |
+                       ((x & 0x000000FF00000000ULL) << 8) |
+                       ((x & 0xF000000000000000ULL) >> 12) |
+                       ((x & 0x0FFF000000000000ULL) << 4);
+            }
+        }
+
+        // 64位字循环移位32位
+        static inline uint64_t rotr32(uint64_t x)
+        {
+            return (x << 32) | (x >> 32);
+        }
+
+        // 列混合(位切片表示下由移位和异或组成)
+        static inline void mix_columns(uint64_t *q)
+        {
+            uint64_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+            uint64_t q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+            uint64_t r0 = (q0 >> 16) | (q0 << 48);
+            uint64_t r1 = (q1 >> 16) | (q1 << 48);
+            uint64_t r2 = (q2 >> 16) | (q2 << 48);
+            uint64_t r3 = (q3 >> 16) | (q3 << 48);
+            uint64_t r4 = (q4 >> 16) | (q4 << 48);
+            uint64_t r5 = (q5 >> 16) | (q5 << 48);
+            uint64_t r6 = (q6 >> 16) | (q6 << 48);
+            uint64_t r7 = (q7 >> 16) | (q7 << 48);
+
+            q[0] = q7 ^ r7 ^ r0 ^ rotr32(q0 ^ r0);
+            q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ rotr32(q1 ^ r1);
+            q[2] = q1 ^ r1 ^ r2 ^ rotr32(q2 ^ r2);
+            q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ rotr32(q3 ^ r3);
+            q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ rotr32(q4 ^ r4);
+            q[5] = q4 ^ r4 ^ r5 ^ rotr32(q5 ^ r5);
+            q[6] = q5 ^ r5 ^ r6 ^ rotr32(q6 ^ r6);
+            q[7] = q6 ^ r6 ^ r7 ^ rotr32(q7 ^ r7);
+        }
+
+        /**
+         * @brief 位切片逆S盒：逆仿射变换 -> S盒电路 -> 逆仿射变换
+         *
+         * S盒为求逆后接仿射变换A，因此InvS(x) = A^-1(Inv(A^-1(x)))，
+         * 而S盒电路本身计算A(Inv(y))，两侧各补一次A^-1(纯线性运算与取反)即可复用同一电路，
+         * 同样不存在依赖数据的查表和分支。
+         *
+         * @param q 8个64位位切片字
+         */
+        static inline void inv_sbox(uint64_t *q)
+        {
+            auto inv_affine = [](uint64_t *v)
+            {
+                uint64_t q0 = ~v[0];
+                uint64_t q1 = ~v[1];
+                uint64_t q2 = v[2];
+                uint64_t q3 = v[3];
+                uint64_t q4 = v[4];
+                uint64_t q5 = ~v[5];
+                uint64_t q6 = ~v[6];
+                uint64_t q7 = v[7];
+                v[7] = q1 ^ q4 ^ q6;
+                v[6] = q0 ^ q3 ^ q5;
+                v[5] = q7 ^ q2 ^ q4;
+                v[4] = q6 ^ q1 ^ q3;
+                v[3] = q5 ^ q0 ^ q2;
+                v[2] = q4 ^ q7 ^ q1;
+                v[1] = q3 ^ q6 ^ q0;
+                v[0] = q2 ^ q5 ^ q7;
+            };
+            inv_affine(q);
+            sbox(q);
+            inv_affine(q);
+        }
+
+        // 逆行移位(shift_rows的逆位置换)
+        static inline void inv_shift_rows(uint64_t *q)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                uint64_t x = q[i];
+                q[i] = (x & 0x000000000000FFFFULL) |
+                       ((x & 0x000000000FFF0000ULL) << 4) |
+                       ((x & 0x00000000F0000000ULL) >> 12) |
+                       ((x & 0x000000FF00000000ULL) << 8) |
+                       ((x & 0x0000FF0000000000ULL) >> 8) |
+                       ((x & 0x000F000000000000ULL) << 12) |
+                       ((x & 0xFFF0000000000000ULL) >> 4);
+            }
+        }
+
+        // 逆列混合(乘以{0e, 0b, 0d, 09}，同样只由移位和异或组成)
+        static inline void inv_mix_columns(uint64_t *q)
+        {
+            uint64_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+            uint64_t q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+            uint64_t r0 = (q0 >> 16) | (q0 << 48);
+            uint64_t r1 = (q1 >> 16) | (q1 << 48);
+            uint64_t r2 = (q2 >> 16) | (q2 << 48);
+            uint64_t r3 = (q3 >> 16) | (q3 << 48);
+            uint64_t r4 = (q4 >> 16) | (q4 << 48);
+            uint64_t r5 = (q5 >> 16) | (q5 << 48);
+            uint64_t r6 = (q6 >> 16) | (q6 << 48);
+            uint64_t r7 = (q7 >> 16) | (q7 << 48);
+
+            q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ rotr32(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+            q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ rotr32(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+            q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ rotr32(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+            q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^ rotr32(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+            q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^ rotr32(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+            q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^ rotr32(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+            q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^ rotr32(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+            q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ rotr32(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+        }
+
+        /**
+         * @brief 对G组位切片状态(每组4个分组)执行AES加密，各组逐步交错推进
+         * @tparam G 组数
+         * @param q G * 8个64位字
+         * @param sliced_keys 位切片轮密钥
+         * @param rounds 轮数
+         */
+        template <int G>
+        static inline void encrypt_sliced(uint64_t *q, const uint64_t *sliced_keys, int rounds)
+        {
+            for (int g = 0; g < G; ++g)
+            {
+                add_round_key(q + 8 * g, sliced_keys);
+            }
+            for (int round = 1; round < rounds; ++round)
+            {
+                for (int g = 0; g < G; ++g)
+                {
+                    sbox(q + 8 * g);
+                    shift_rows(q + 8 * g);
+                    mix_columns(q + 8 * g);
+                    add_round_key(q + 8 * g, sliced_keys + round * SLICED_WORDS_PER_ROUND);
+                }
+            }
+            for (int g = 0; g < G; ++g)
+            {
+                sbox(q + 8 * g);
+                shift_rows(q + 8 * g);
+                add_round_key(q + 8 * g, sliced_keys + rounds * SLICED_WORDS_PER_ROUND);
+            }
+        }
+
+        /**
+         * @brief 对G组位切片状态执行AES解密(标准逆密码)，使用与加密相同的位切片轮密钥
+         * @tparam G 组数
+         * @param q G * 8个64位字
+         * @param sliced_keys 位切片轮密钥
+         * @param rounds 轮数
+         */
+        template <int G>
+        static inline void decrypt_sliced(uint64_t *q, const uint64_t *sliced_keys, int rounds)
+        {
+            for (int g = 0; g < G; ++g)
+            {
+                add_round_key(q + 8 * g, sliced_keys + rounds * SLICED_WORDS_PER_ROUND);
+            }
+            for (int round = rounds - 1; round > 0; --round)
+            {
+                for (int g = 0; g < G; ++g)
+                {
+                    inv_shift_rows(q + 8 * g);
+                    inv_sbox(q + 8 * g);
+                    add_round_key(q + 8 * g, sliced_keys + round * SLICED_WORDS_PER_ROUND);
+                    inv_mix_columns(q + 8 * g);
+                }
+            }
+            for (int g = 0; g < G; ++g)
+            {
+                inv_shift_rows(q + 8 * g);
+                inv_sbox(q + 8 * g);
+                add_round_key(q + 8 * g, sliced_keys);
+            }
+        }
+
+        /**
+         * @brief 常数时间字替换SubWord：4个字节同时经过位切片S盒
+         * @param x 小端序32位字
+         * @return 替换后的字
+         */
+        static uint32_t sub_word(uint32_t x)
+        {
+            uint64_t q[8] = {x, 0, 0, 0, 0, 0, 0, 0};
+            ortho(q);
+            sbox(q);
+            ortho(q);
+            return static_cast<uint32_t>(q[0]);
+        }
+
+        int key_expansion(const uint8_t *key, size_t key_len, uint8_t *round_key_bytes)
+        {
+            // 轮常量(作用于小端序字的最低字节)
+            static const uint32_t RCON[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+            int rounds;
+            if (key_len == 16)
+                rounds = 10; // 128位密钥
+            else if (key_len == 24)
+                rounds = 12; // 192位密钥
+            else if (key_len == 32)
+                rounds = 14; // 256位密钥
+            else
+                throw std::invalid_argument("无效的AES密钥长度，必须是16、24或32字节");
+
+            int nk = static_cast<int>(key_len / 4);
+            int total_words = (rounds + 1) * 4;
+            uint32_t words[60];
+            for (int i = 0; i < nk; ++i)
+            {
+                words[i] = load32le(key + 4 * i);
+            }
+
+            uint32_t tmp = words[nk - 1];
+            for (int i = nk, j = 0, k = 0; i < total_words; ++i)
+            {
+                if (j == 0)
+                {
+                    // RotWord(小端序下为循环右移8位)、SubWord与Rcon异或
+                    tmp = (tmp << 24) | (tmp >> 8);
+                    tmp = sub_word(tmp) ^ RCON[k];
+                }
+                else if (nk > 6 && j == 4)
+                {
+                    // 256位密钥额外处理
+                    tmp = sub_word(tmp);
+                }
+                tmp ^= words[i - nk];
+                words[i] = tmp;
+                if (++j == nk)
+                {
+                    j = 0;
+                    ++k;
+                }
+            }
+
+            for (int i = 0; i < total_words; ++i)
+            {
+                store32le(round_key_bytes + 4 * i, words[i]);
+            }
+            // 清除栈上的密钥材料
+            volatile uint32_t *wipe = words;
+            for (int i = 0; i < total_words; ++i)
+            {
+                wipe[i] = 0;
+            }
+            return rounds;
+        }
+
+        void slice_round_keys(const uint8_t *round_key_bytes, int rounds, uint64_t *sliced_keys)
+        {
+            // 同一轮密钥复制到4个分组槽位，与数据使用同一位切片布局
+            uint8_t replicated[64];
+            for (int round = 0; round <= rounds; ++round)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    memcpy(replicated + 16 * i, round_key_bytes + 16 * round, 16);
+                }
+                load4(sliced_keys + round * SLICED_WORDS_PER_ROUND, replicated);
+            }
+            memset(replicated, 0, sizeof(replicated));
+        }
+
+        void encrypt8(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output)
+        {
+            uint64_t q[16];
+            load4(q, input);
+            load4(q + 8, input + 64);
+            encrypt_sliced<2>(q, sliced_keys, rounds);
+            store4(output, q);
+            store4(output + 64, q + 8);
+        }
+
+        void decrypt8(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output)
+        {
+            uint64_t q[16];
+            load4(q, input);
+            load4(q + 8, input + 64);
+            decrypt_sliced<2>(q, sliced_keys, rounds);
+            store4(output, q);
+            store4(output + 64, q + 8);
+        }
+
+        /**
+         * @brief 按8个分组一批处理任意数量的分组，尾部不足8个时补零到4或8个分组后处理，只写回有效部分
+         * @tparam Decrypt 为true时解密，否则加密
+         */
+        template <bool Decrypt>
+        static void process_blocks(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            size_t i = 0;
+            for (; i + 8 <= block_count; i += 8)
+            {
+                if constexpr (Decrypt)
+                    decrypt8(sliced_keys, rounds, input + 16 * i, output + 16 * i);
+                else
+                    encrypt8(sliced_keys, rounds, input + 16 * i, output + 16 * i);
+            }
+
+            size_t rest = block_count - i;
+            if (rest == 0)
+            {
+                return;
+            }
+            uint8_t buffer[128] = {0};
+            memcpy(buffer, input + 16 * i, rest * 16);
+            if (rest <= 4)
+            {
+                uint64_t q[8];
+                load4(q, buffer);
+                if constexpr (Decrypt)
+                    decrypt_sliced<1>(q, sliced_keys, rounds);
+                else
+                    encrypt_sliced<1>(q, sliced_keys, rounds);
+                store4(buffer, q);
+            }
+            else
+            {
+                if constexpr (Decrypt)
+                    decrypt8(sliced_keys, rounds, buffer, buffer);
+                else
+                    encrypt8(sliced_keys, rounds, buffer, buffer);
+            }
+            memcpy(output + 16 * i, buffer, rest * 16);
+            memset(buffer, 0, sizeof(buffer));
+        }
+
+        void encrypt_blocks(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            process_blocks<false>(sliced_keys, rounds, input, output, block_count);
+        }
+
+        void decrypt_blocks(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            process_blocks<true>(sliced_keys, rounds, input, output, block_count);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef AES_BITSLICE_H
+#define AES_BITSLICE_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OPRFTools
+{
+    // 位切片(bitsliced)常数时间AES内核(加密与解密)
+    // 只使用64位整数的与、异或、移位运算，不存在依赖数据的查表和分支，
+    // 适用于没有AES指令的平台。每个64位字承载4个分组的同一比特位，
+    // 一次调用交错处理两组共8个分组。
+    // 轮数与轮密钥的约定与AES_NI内核相同：共rounds + 1个16字节轮密钥。
+    namespace AES_Bitslice
+    {
+        // 每个轮密钥展开为位切片形式后占用的64位字数
+        constexpr size_t SLICED_WORDS_PER_ROUND = 8;
+
+        /**
+         * @brief 常数时间AES密钥扩展(S盒通过位切片电路计算)
+         * @param key 原始密钥
+         * @param key_len 密钥长度(字节)，必须为16、24或32
+         * @param round_key_bytes 输出的字节序轮密钥，至少240字节
+         * @return 标准AES轮数(10、12或14)
+         * @throws std::invalid_argument 当密钥长度不是16、24或32字节时抛出异常
+         */
+        int key_expansion(const uint8_t *key, size_t key_len, uint8_t *round_key_bytes);
+
+        /**
+         * @brief 将字节序轮密钥转换为位切片形式
+         * @param round_key_bytes 字节序轮密钥，共(rounds + 1) * 16字节
+         * @param rounds 轮数
+         * @param sliced_keys 输出，共(rounds + 1) * SLICED_WORDS_PER_ROUND个64位字
+         */
+        void slice_round_keys(const uint8_t *round_key_bytes, int rounds, uint64_t *sliced_keys);
+
+        /**
+         * @brief 加密8个相互独立的分组
+         * @param sliced_keys 位切片轮密钥
+         * @param rounds 轮数
+         * @param input 128字节输入(8个分组)
+         * @param output 128字节输出，可与input相同
+         */
+        void encrypt8(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output);
+
+        /**
+         * @brief 加密任意数量的相互独立分组，每次调用内核处理8个(尾部不足时处理4个)
+         * @param sliced_keys 位切片轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void encrypt_blocks(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+
+        /**
+         * @brief 解密8个相互独立的分组(逆S盒、逆列混合同样为位切片电路)
+         * @param sliced_keys 位切片轮密钥(与加密相同)
+         * @param rounds 轮数
+         * @param input 128字节输入(8个分组)
+         * @param output 128字节输出，可与input相同
+         */
+        void decrypt8(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output);
+
+        /**
+         * @brief 解密任意数量的相互独立分组，每次调用内核处理8个(尾部不足时处理4个)
+         * @param sliced_keys 位切片轮密钥(与加密相同)
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void decrypt_blocks(const uint64_t *sliced_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+    }
+}
+
+#endif // AES_BITSLICE_H
@@ -0,0 +1,442 @@
+#include "AES_Core.h"
+#include "AES_NI.h"
+#include "AES_VAES.h"
+#include "AES_Bitslice.h"
+#include "PRF_AES_Fixed.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <utility>
+
+namespace OPRFTools
+{
+    // 查表后端分组加密函数的类型
+    using TableEncryptFn = void (*)(const uint32_t *, const uint8_t *, uint8_t *);
+
+    // 位切片后端融合异或时每次处理的分组数(与内核的8路并行对齐，同时限制栈上临时缓冲区大小)
+    static constexpr size_t BITSLICE_CHUNK = 64;
+
+    /**
+     * @brief 类型擦除：把运行时的轮数映射到编译期展开的PRF_AES_Fixed::encrypt_rounds特化
+     * @tparam KeyBits 密钥位数
+     * @param rounds 轮数，范围[1, 标准轮数]
+     * @return 对应的分组加密函数
+     */
+    template <int KeyBits, int... R>
+    static TableEncryptFn select_table_encrypt(int rounds, std::integer_sequence<int, R...>)
+    {
+        static constexpr TableEncryptFn functions[] = {&PRF_AES_Fixed<KeyBits>::template encrypt_rounds<R + 1>...};
+        return functions[rounds - 1];
+    }
+
+    /**
+     * @brief GF(2^8)上的乘法，用于逆列混合
+     * @param a 被乘数
+     * @param b 乘数(逆列混合中只会是9、11、13、14)
+     * @return a * b
+     */
+    static uint8_t gf_mul(uint8_t a, uint8_t b)
+    {
+        uint8_t product = 0;
+        while (b)
+        {
+            if (b & 1)
+            {
+                product ^= a;
+            }
+            a = AES_Tables::xtime(a);
+            b >>= 1;
+        }
+        return product;
+    }
+
+    /**
+     * @brief 可移植的逐字节AES解密(标准逆密码)，供查表后端使用
+     *
+     * 逆S盒按字节查表，访问位置依赖数据；需要常数时间解密时应使用位切片后端。
+     *
+     * 状态按列优先存放：第c列第r行为state[r + 4 * c]。
+     *
+     * @param round_key_bytes 字节序加密轮密钥
+     * @param rounds 轮数
+     * @param input 16字节输入
+     * @param output 16字节输出，可与input相同
+     */
+    static void decrypt_block_portable(const uint8_t *round_key_bytes, int rounds, const uint8_t *input, uint8_t *output)
+    {
+        const auto &inv_sbox = AES_Tables::INV_SBOX;
+        uint8_t state[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            state[i] = input[i] ^ round_key_bytes[16 * rounds + i];
+        }
+
+        for (int round = rounds - 1; round >= 0; --round)
+        {
+            // 逆行移位与逆字节替换
+            uint8_t shifted[16];
+            for (int c = 0; c < 4; ++c)
+            {
+                for (int r = 0; r < 4; ++r)
+                {
+                    shifted[r + 4 * ((c + r) & 3)] = inv_sbox[state[r + 4 * c]];
+                }
+            }
+
+            // 轮密钥加
+            for (int i = 0; i < 16; ++i)
+            {
+                state[i] = shifted[i] ^ round_key_bytes[16 * round + i];
+            }
+
+            // 逆列混合(最后一步没有)
+            if (round > 0)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    uint8_t *col = state + 4 * c;
+                    uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                    col[0] = gf_mul(a0, 14) ^ gf_mul(a1, 11) ^ gf_mul(a2, 13) ^ gf_mul(a3, 9);
+                    col[1] = gf_mul(a0, 9) ^ gf_mul(a1, 14) ^ gf_mul(a2, 11) ^ gf_mul(a3, 13);
+                    col[2] = gf_mul(a0, 13) ^ gf_mul(a1, 9) ^ gf_mul(a2, 14) ^ gf_mul(a3, 11);
+                    col[3] = gf_mul(a0, 11) ^ gf_mul(a1, 13) ^ gf_mul(a2, 9) ^ gf_mul(a3, 14);
+                }
+            }
+        }
+
+        memcpy(output, state, 16);
+    }
+
+    /**
+     * @brief 扩展密钥，按所选后端准备轮密钥
+     *
+     * 位切片后端使用常数时间密钥扩展，其余后端使用编译期展开的查表密钥扩展；
+     * 硬件后端额外生成解密轮密钥，位切片后端额外生成位切片轮密钥。
+     *
+     * @param key 原始密钥
+     * @param key_len 密钥长度(字节)
+     * @param backend 加密后端
+     * @param rounds 执行的轮数，为0时使用标准轮数
+     */
+    AESCore::AESCore(const uint8_t *key, size_t key_len, AESBackend backend, int rounds) : schedule_{}, backend_(backend)
+    {
+        if (key_len != 16 && key_len != 24 && key_len != 32)
+        {
+            throw std::invalid_argument("AES密钥长度必须是16字节(128位)、24字节(192位)或32字节(256位)");
+        }
+        if (!backend_supported(backend_))
+        {
+            throw std::invalid_argument(std::string("当前CPU不支持AES后端: ") + backend_name(backend_));
+        }
+
+        schedule_.key_rounds = static_cast<int>(key_len / 4) + 6;
+        rounds_ = rounds == 0 ? schedule_.key_rounds : rounds;
+        if (rounds_ < 1 || rounds_ > schedule_.key_rounds)
+        {
+            throw std::invalid_argument("AES轮数超出轮密钥范围");
+        }
+
+        switch (key_len)
+        {
+        case 16:
+            table_encrypt_ = select_table_encrypt<128>(rounds_, std::make_integer_sequence<int, 10>{});
+            break;
+        case 24:
+            table_encrypt_ = select_table_encrypt<192>(rounds_, std::make_integer_sequence<int, 12>{});
+            break;
+        default:
+            table_encrypt_ = select_table_encrypt<256>(rounds_, std::make_integer_sequence<int, 14>{});
+            break;
+        }
+
+        const int words = (schedule_.key_rounds + 1) * 4;
+        if (backend_ == AESBackend::Bitslice)
+        {
+            // 位切片后端：密钥扩展同样不查表，整个流程与密钥和数据无关地恒定耗时
+            AES_Bitslice::key_expansion(key, key_len, schedule_.round_key_bytes);
+            for (int i = 0; i < words; ++i)
+            {
+                const uint8_t *p = schedule_.round_key_bytes + i * 4;
+                schedule_.round_keys[i] = (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+                                          (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+            }
+            AES_Bitslice::slice_round_keys(schedule_.round_key_bytes, rounds_, schedule_.sliced_round_keys);
+            return;
+        }
+
+        switch (key_len)
+        {
+        case 16:
+            PRF_AES_Fixed<128>::expand_key(key, schedule_.round_keys);
+            break;
+        case 24:
+            PRF_AES_Fixed<192>::expand_key(key, schedule_.round_keys);
+            break;
+        default:
+            PRF_AES_Fixed<256>::expand_key(key, schedule_.round_keys);
+            break;
+        }
+
+        // 将大端字形式的轮密钥展开为字节序，供硬件后端直接加载
+        for (int i = 0; i < words; ++i)
+        {
+            uint32_t word = schedule_.round_keys[i];
+            schedule_.round_key_bytes[i * 4] = static_cast<uint8_t>(word >> 24);
+            schedule_.round_key_bytes[i * 4 + 1] = static_cast<uint8_t>(word >> 16);
+            schedule_.round_key_bytes[i * 4 + 2] = static_cast<uint8_t>(word >> 8);
+            schedule_.round_key_bytes[i * 4 + 3] = static_cast<uint8_t>(word);
+        }
+
+        if (backend_ == AESBackend::AESNI || backend_ == AESBackend::VAES)
+        {
+            AES_NI::inverse_round_keys(schedule_.round_key_bytes, rounds_, schedule_.inverse_round_key_bytes);
+        }
+    }
+
+    /**
+     * @brief 析构时清除所有形式的轮密钥，防止内存中残留敏感数据
+     */
+    AESCore::~AESCore()
+    {
+        std::fill(std::begin(schedule_.round_keys), std::end(schedule_.round_keys), 0);
+        std::fill(std::begin(schedule_.round_key_bytes), std::end(schedule_.round_key_bytes), 0);
+        std::fill(std::begin(schedule_.inverse_round_key_bytes), std::end(schedule_.inverse_round_key_bytes), 0);
+        std::fill(std::begin(schedule_.sliced_round_keys), std::end(schedule_.sliced_round_keys), 0);
+    }
+
+    /**
+     * @brief 加密单个分组；单个分组无法填满宽寄存器，VAES后端同样使用AES-NI
+     * @param input 16字节输入
+     * @param output 16字节输出，可与input相同
+     */
+    void AESCore::encrypt_block(const uint8_t *input, uint8_t *output) const
+    {
+        switch (backend_)
+        {
+        case AESBackend::AESNI:
+        case AESBackend::VAES:
+            AES_NI::encrypt_block(schedule_.round_key_bytes, rounds_, input, output);
+            break;
+        case AESBackend::Bitslice:
+            AES_Bitslice::encrypt_blocks(schedule_.sliced_round_keys, rounds_, input, output, 1);
+            break;
+        case AESBackend::Table:
+            table_encrypt_(schedule_.round_keys, input, output);
+            break;
+        }
+    }
+
+    /**
+     * @brief 加密若干相互独立的分组
+     *
+     * 硬件后端交错推进多个分组，使AES流水线保持满载，VAES后端每条指令处理4个分组；
+     * 位切片后端每次内核调用处理8个分组；查表后端逐块加密。
+     *
+     * @param input 输入分组，长度为block_count * 16字节
+     * @param output 输出分组，可与input相同
+     * @param block_count 分组数
+     */
+    void AESCore::encrypt_blocks(const uint8_t *input, uint8_t *output, size_t block_count) const
+    {
+        switch (backend_)
+        {
+        case AESBackend::VAES:
+            AES_VAES::encrypt_blocks(schedule_.round_key_bytes, rounds_, input, output, block_count);
+            break;
+        case AESBackend::AESNI:
+            AES_NI::encrypt_blocks(schedule_.round_key_bytes, rounds_, input, output, block_count);
+            break;
+        case AESBackend::Bitslice:
+            AES_Bitslice::encrypt_blocks(schedule_.sliced_round_keys, rounds_, input, output, block_count);
+            break;
+        case AESBackend::Table:
+            for (size_t i = 0; i < block_count; ++i)
+            {
+                table_encrypt_(schedule_.round_keys, input + 16 * i, output + 16 * i);
+            }
+            break;
+        }
+    }
+
+    /**
+     * @brief 加密若干相互独立的分组并与输入异或
+     *
+     * 硬件后端在一个内核中完成加密与异或；位切片后端按块加密到临时缓冲区后再与输入异或。
+     *
+     * @param input 输入分组，长度为block_count * 16字节
+     * @param output 输出分组，可与input相同
+     * @param block_count 分组数
+     */
+    void AESCore::encrypt_xor_blocks(const uint8_t *input, uint8_t *output, size_t block_count) const
+    {
+        switch (backend_)
+        {
+        case AESBackend::VAES:
+            AES_VAES::encrypt_xor_blocks(schedule_.round_key_bytes, rounds_, input, output, block_count);
+            break;
+
+        case AESBackend::AESNI:
+            AES_NI::encrypt_xor_blocks(schedule_.round_key_bytes, rounds_, input, output, block_count);
+            break;
+
+        case AESBackend::Bitslice:
+            for (size_t base = 0; base < block_count; base += BITSLICE_CHUNK)
+            {
+                size_t n = std::min(BITSLICE_CHUNK, block_count - base);
+                uint8_t buffer[BITSLICE_CHUNK * 16];
+                AES_Bitslice::encrypt_blocks(schedule_.sliced_round_keys, rounds_, input + base * 16, buffer, n);
+                for (size_t i = 0; i < n * 16; ++i)
+                {
+                    output[base * 16 + i] = buffer[i] ^ input[base * 16 + i];
+                }
+            }
+            break;
+
+        case AESBackend::Table:
+            for (size_t i = 0; i < block_count; ++i)
+            {
+                uint8_t block[16];
+                table_encrypt_(schedule_.round_keys, input + i * 16, block);
+                for (int j = 0; j < 16; ++j)
+                {
+                    output[i * 16 + j] = block[j] ^ input[i * 16 + j];
+                }
+            }
+            break;
+        }
+    }
+
+    /**
+     * @brief CBC-MAC链式处理若干完整分组
+     *
+     * 单条链严格串行：硬件后端在寄存器中一次处理完整条链，其余后端逐块加密。
+     *
+     * @param data 输入数据，长度为block_count * 16字节
+     * @param block_count 完整分组数
+     * @param state 16字节链状态，既是输入也是输出
+     */
+    void AESCore::cbc_mac(const uint8_t *data, size_t block_count, uint8_t *state) const
+    {
+        if (backend_ == AESBackend::AESNI || backend_ == AESBackend::VAES)
+        {
+            AES_NI::cbc_mac(schedule_.round_key_bytes, rounds_, data, block_count, state);
+            return;
+        }
+
+        for (size_t b = 0; b < block_count; ++b)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                state[i] ^= data[b * 16 + i];
+            }
+            encrypt_block(state, state);
+        }
+    }
+
+    /**
+     * @brief 解密单个分组
+     * @param input 16字节输入
+     * @param output 16字节输出，可与input相同
+     */
+    void AESCore::decrypt_block(const uint8_t *input, uint8_t *output) const
+    {
+        if (backend_ == AESBackend::AESNI || backend_ == AESBackend::VAES)
+        {
+            AES_NI::decrypt_blocks(schedule_.inverse_round_key_bytes, rounds_, input, output, 1);
+            return;
+        }
+        if (backend_ == AESBackend::Bitslice)
+        {
+            AES_Bitslice::decrypt_blocks(schedule_.sliced_round_keys, rounds_, input, output, 1);
+            return;
+        }
+        decrypt_block_portable(schedule_.round_key_bytes, rounds_, input, output);
+    }
+
+    /**
+     * @brief 解密若干相互独立的分组
+     * @param input 输入分组，长度为block_count * 16字节
+     * @param output 输出分组，可与input相同
+     * @param block_count 分组数
+     */
+    void AESCore::decrypt_blocks(const uint8_t *input, uint8_t *output, size_t block_count) const
+    {
+        switch (backend_)
+        {
+        case AESBackend::VAES:
+            AES_VAES::decrypt_blocks(schedule_.inverse_round_key_bytes, rounds_, input, output, block_count);
+            break;
+        case AESBackend::AESNI:
+            AES_NI::decrypt_blocks(schedule_.inverse_round_key_bytes, rounds_, input, output, block_count);
+            break;
+        case AESBackend::Bitslice:
+            AES_Bitslice::decrypt_blocks(schedule_.sliced_round_keys, rounds_, input, output, block_count);
+            break;
+        case AESBackend::Table:
+            for (size_t i = 0; i < block_count; ++i)
+            {
+                decrypt_block_portable(schedule_.round_key_bytes, rounds_, input + 16 * i, output + 16 * i);
+            }
+            break;
+        }
+    }
+
+    /**
+     * @brief 通过CPUID检测当前CPU上可用的最快后端
+     *
+     * 没有AES指令时选择位切片后端而不是查表后端：
+     * 位切片后端批量吞吐更高，且不存在依赖数据的缓存访问时序泄露。
+     *
+     * @return 支持VAES + AVX-512时返回VAES，仅支持AES-NI时返回AESNI，否则返回Bitslice
+     */
+    AESBackend AESCore::detect_backend()
+    {
+        if (AES_VAES::supported())
+        {
+            return AESBackend::VAES;
+        }
+        return AES_NI::supported() ? AESBackend::AESNI : AESBackend::Bitslice;
+    }
+
+    /**
+     * @brief 判断指定后端在当前CPU上是否可用
+     * @param backend 待检测的后端
+     * @return true：可用；false：不可用
+     */
+    bool AESCore::backend_supported(AESBackend backend)
+    {
+        switch (backend)
+        {
+        case AESBackend::Table:
+        case AESBackend::Bitslice:
+            return true;
+        case AESBackend::AESNI:
+            return AES_NI::supported();
+        case AESBackend::VAES:
+            return AES_VAES::supported();
+        }
+        return false;
+    }
+
+    /**
+     * @brief 获取后端的可读名称
+     * @param backend 后端
+     * @return 后端名称字符串
+     */
+    const char *AESCore::backend_name(AESBackend backend)
+    {
+        switch (backend)
+        {
+        case AESBackend::Table:
+            return "table";
+        case AESBackend::Bitslice:
+            return "bitslice";
+        case AESBackend::AESNI:
+            return "aes-ni";
+        case AESBackend::VAES:
+            return "vaes";
+        }
+        return "unknown";
+    }
+}
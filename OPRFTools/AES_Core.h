@@ -0,0 +1,95 @@
+#ifndef AES_CORE_H
+#define AES_CORE_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OPRFTools
+{
+    // AES分组加密后端
+    enum class AESBackend
+    {
+        Table,    // 可移植的T表实现(按密钥长度分派到PRF_AES_Fixed)
+        Bitslice, // 可移植的位切片常数时间实现(一次处理8个分组)
+        AESNI,    // x86-64 AES-NI硬件指令
+        VAES      // x86-64 VAES + AVX-512宽指令(批量路径一次推进16个分组，单块与单链路径使用AES-NI)
+    };
+
+    // 统一的AES引擎：密钥只扩展一次，单块/批量加解密与CBC-MAC按后端分派到对应内核。
+    // PRF_AES、PRP_AES与FixedKeyAESHash共用本模块，内核上的优化只需做一次。
+    // rounds可少于密钥长度对应的标准轮数(PRF_AES使用Nr-1轮的变体)，
+    // 此时使用前rounds + 1个轮密钥，最后一轮同样不含列混合。
+    class AESCore
+    {
+    public:
+        // 扩展后的密钥，同时保存各后端所需的形式
+        struct KeySchedule
+        {
+            uint32_t round_keys[60];                          // 大端字轮密钥，供查表后端使用
+            alignas(16) uint8_t round_key_bytes[240];         // 字节序加密轮密钥，供硬件后端与可移植解密使用
+            alignas(16) uint8_t inverse_round_key_bytes[240]; // 等价逆密码的解密轮密钥，供硬件后端使用
+            uint64_t sliced_round_keys[15 * 8];               // 位切片轮密钥，供位切片后端使用
+            int key_rounds;                                   // 密钥长度对应的标准轮数(10、12或14)
+        };
+
+        /**
+         * @brief 扩展密钥并选择后端
+         * @param key 原始密钥
+         * @param key_len 密钥长度(字节)，必须为16、24或32
+         * @param backend 加密后端
+         * @param rounds 执行的轮数，为0时使用标准轮数
+         * @throws std::invalid_argument 当密钥长度、轮数不合法或后端不被当前CPU支持时抛出异常
+         */
+        AESCore(const uint8_t *key, size_t key_len, AESBackend backend, int rounds = 0);
+
+        // 引擎只包含轮密钥与后端选择，可以复制(用于给工作线程分发独立副本)
+        AESCore(const AESCore &) = default;
+        AESCore &operator=(const AESCore &) = default;
+
+        // 析构时清除轮密钥
+        ~AESCore();
+
+        // 加密单个分组，output可与input相同
+        void encrypt_block(const uint8_t *input, uint8_t *output) const;
+
+        // 加密若干相互独立的分组，output可与input相同
+        void encrypt_blocks(const uint8_t *input, uint8_t *output, size_t block_count) const;
+
+        // 加密若干相互独立的分组并与输入异或：output_i = E(input_i) ^ input_i
+        void encrypt_xor_blocks(const uint8_t *input, uint8_t *output, size_t block_count) const;
+
+        // CBC-MAC链式处理若干完整分组：state = E(state ^ block_i)
+        void cbc_mac(const uint8_t *data, size_t block_count, uint8_t *state) const;
+
+        // 解密单个分组，output可与input相同
+        void decrypt_block(const uint8_t *input, uint8_t *output) const;
+
+        // 解密若干相互独立的分组，output可与input相同
+        // 位切片后端使用位切片逆电路，同样常数时间；查表后端使用可移植的逐字节实现
+        void decrypt_blocks(const uint8_t *input, uint8_t *output, size_t block_count) const;
+
+        // 获取当前使用的后端
+        AESBackend backend() const { return backend_; }
+
+        // 获取执行的轮数
+        int rounds() const { return rounds_; }
+
+        // 检测当前CPU上可用的最快后端
+        static AESBackend detect_backend();
+
+        // 判断指定后端在当前CPU上是否可用
+        static bool backend_supported(AESBackend backend);
+
+        // 获取后端名称，便于日志输出
+        static const char *backend_name(AESBackend backend);
+
+    private:
+        KeySchedule schedule_;
+        AESBackend backend_;
+        int rounds_;
+        // 查表后端的分组加密函数，指向与密钥长度和轮数对应的PRF_AES_Fixed特化
+        void (*table_encrypt_)(const uint32_t *round_keys, const uint8_t *input, uint8_t *output);
+    };
+}
+
+#endif // AES_CORE_H
@@ -0,0 +1,236 @@
+#include "AES_NI.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AES_NI_AVAILABLE 1
+#define AES_NI_TARGET __attribute__((target("aes,sse2")))
+#endif
+
+namespace OPRFTools
+{
+    namespace AES_NI
+    {
+#ifdef AES_NI_AVAILABLE
+        /**
+         * @brief 将字节序轮密钥加载到寄存器数组
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param rk 输出的寄存器数组，至少rounds + 1个元素
+         */
+        AES_NI_TARGET static inline void load_round_keys(const uint8_t *round_keys, int rounds, __m128i *rk)
+        {
+            for (int i = 0; i <= rounds; ++i)
+            {
+                rk[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(round_keys + 16 * i));
+            }
+        }
+
+        /**
+         * @brief 对寄存器中的单个分组执行AES加密
+         * @param rk 轮密钥寄存器数组
+         * @param rounds 轮数
+         * @param block 待加密分组
+         * @return 加密后的分组
+         */
+        AES_NI_TARGET static inline __m128i encrypt_si128(const __m128i *rk, int rounds, __m128i block)
+        {
+            block = _mm_xor_si128(block, rk[0]);
+            for (int round = 1; round < rounds; ++round)
+            {
+                block = _mm_aesenc_si128(block, rk[round]);
+            }
+            return _mm_aesenclast_si128(block, rk[rounds]);
+        }
+
+        bool supported()
+        {
+            // 只检测一次，结果在进程生命周期内不变
+            static const bool has_aesni = []
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul");
+            }();
+            return has_aesni;
+        }
+
+        AES_NI_TARGET void encrypt_block(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output)
+        {
+            // 单个分组：轮密钥直接从内存读取，无需先整体加载到寄存器数组
+            const __m128i *rk = reinterpret_cast<const __m128i *>(round_keys);
+            __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input)), _mm_loadu_si128(rk));
+            for (int round = 1; round < rounds; ++round)
+            {
+                block = _mm_aesenc_si128(block, _mm_loadu_si128(rk + round));
+            }
+            block = _mm_aesenclast_si128(block, _mm_loadu_si128(rk + rounds));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(output), block);
+        }
+
+        AES_NI_TARGET void encrypt_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            __m128i rk[15];
+            load_round_keys(round_keys, rounds, rk);
+
+            size_t i = 0;
+            // 8路交错：各分组之间没有数据依赖，aesenc可以背靠背发射
+            for (; i + 8 <= block_count; i += 8)
+            {
+                __m128i b[8];
+                for (int j = 0; j < 8; ++j)
+                {
+                    b[j] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * (i + j))), rk[0]);
+                }
+                for (int round = 1; round < rounds; ++round)
+                {
+                    for (int j = 0; j < 8; ++j)
+                    {
+                        b[j] = _mm_aesenc_si128(b[j], rk[round]);
+                    }
+                }
+                for (int j = 0; j < 8; ++j)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * (i + j)), _mm_aesenclast_si128(b[j], rk[rounds]));
+                }
+            }
+
+            // 剩余不足8个的分组逐个处理
+            for (; i < block_count; ++i)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * i), encrypt_si128(rk, rounds, block));
+            }
+        }
+
+        AES_NI_TARGET void encrypt_xor_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            __m128i rk[15];
+            load_round_keys(round_keys, rounds, rk);
+
+            size_t i = 0;
+            for (; i + 8 <= block_count; i += 8)
+            {
+                __m128i x[8];
+                __m128i b[8];
+                for (int j = 0; j < 8; ++j)
+                {
+                    x[j] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * (i + j)));
+                    b[j] = _mm_xor_si128(x[j], rk[0]);
+                }
+                for (int round = 1; round < rounds; ++round)
+                {
+                    for (int j = 0; j < 8; ++j)
+                    {
+                        b[j] = _mm_aesenc_si128(b[j], rk[round]);
+                    }
+                }
+                for (int j = 0; j < 8; ++j)
+                {
+                    b[j] = _mm_xor_si128(_mm_aesenclast_si128(b[j], rk[rounds]), x[j]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * (i + j)), b[j]);
+                }
+            }
+
+            for (; i < block_count; ++i)
+            {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * i), _mm_xor_si128(encrypt_si128(rk, rounds, x), x));
+            }
+        }
+
+        AES_NI_TARGET void cbc_mac(const uint8_t *round_keys, int rounds, const uint8_t *data, size_t block_count, uint8_t *state)
+        {
+            __m128i rk[15];
+            load_round_keys(round_keys, rounds, rk);
+
+            // 链状态全程保存在寄存器中，避免每块往返内存
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+            for (size_t i = 0; i < block_count; ++i)
+            {
+                __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i));
+                block = encrypt_si128(rk, rounds, _mm_xor_si128(block, in));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(state), block);
+        }
+
+        AES_NI_TARGET void inverse_round_keys(const uint8_t *round_keys, int rounds, uint8_t *inverse_keys)
+        {
+            // 等价逆密码：轮密钥倒序，中间各轮密钥先做逆列混合
+            const __m128i *rk = reinterpret_cast<const __m128i *>(round_keys);
+            __m128i *dk = reinterpret_cast<__m128i *>(inverse_keys);
+            _mm_storeu_si128(dk, _mm_loadu_si128(rk + rounds));
+            for (int i = 1; i < rounds; ++i)
+            {
+                _mm_storeu_si128(dk + i, _mm_aesimc_si128(_mm_loadu_si128(rk + rounds - i)));
+            }
+            _mm_storeu_si128(dk + rounds, _mm_loadu_si128(rk));
+        }
+
+        AES_NI_TARGET void decrypt_blocks(const uint8_t *inverse_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            __m128i dk[15];
+            load_round_keys(inverse_keys, rounds, dk);
+
+            size_t i = 0;
+            for (; i + 8 <= block_count; i += 8)
+            {
+                __m128i b[8];
+                for (int j = 0; j < 8; ++j)
+                {
+                    b[j] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * (i + j))), dk[0]);
+                }
+                for (int round = 1; round < rounds; ++round)
+                {
+                    for (int j = 0; j < 8; ++j)
+                    {
+                        b[j] = _mm_aesdec_si128(b[j], dk[round]);
+                    }
+                }
+                for (int j = 0; j < 8; ++j)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * (i + j)), _mm_aesdeclast_si128(b[j], dk[rounds]));
+                }
+            }
+
+            for (; i < block_count; ++i)
+            {
+                __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16 * i)), dk[0]);
+                for (int round = 1; round < rounds; ++round)
+                {
+                    block = _mm_aesdec_si128(block, dk[round]);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * i), _mm_aesdeclast_si128(block, dk[rounds]));
+            }
+        }
+#else
+        // 非x86平台：内核不可用，调用方应回退到可移植实现
+        bool supported()
+        {
+            return false;
+        }
+
+        void encrypt_block(const uint8_t *, int, const uint8_t *, uint8_t *)
+        {
+        }
+
+        void encrypt_blocks(const uint8_t *, int, const uint8_t *, uint8_t *, size_t)
+        {
+        }
+
+        void encrypt_xor_blocks(const uint8_t *, int, const uint8_t *, uint8_t *, size_t)
+        {
+        }
+
+        void cbc_mac(const uint8_t *, int, const uint8_t *, size_t, uint8_t *)
+        {
+        }
+
+        void inverse_round_keys(const uint8_t *, int, uint8_t *)
+        {
+        }
+
+        void decrypt_blocks(const uint8_t *, int, const uint8_t *, uint8_t *, size_t)
+        {
+        }
+#endif
+    }
+}
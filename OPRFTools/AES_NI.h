@@ -0,0 +1,79 @@
+#ifndef AES_NI_H
+#define AES_NI_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OPRFTools
+{
+    // 基于x86-64 AES-NI指令的AES分组加密内核
+    // 轮密钥按字节序连续存放，共(rounds + 1) * 16字节：
+    // 第0个轮密钥用于初始轮密钥加，第1~rounds-1个用于完整轮，第rounds个用于最后一轮(不含列混合)
+    namespace AES_NI
+    {
+        /**
+         * @brief 运行时检测当前CPU是否支持AES-NI(及同代的PCLMULQDQ)指令
+         * @return true：可以使用本内核；false：只能使用可移植实现
+         */
+        bool supported();
+
+        /**
+         * @brief 加密单个16字节分组
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param input 16字节输入
+         * @param output 16字节输出，可与input相同
+         */
+        void encrypt_block(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output);
+
+        /**
+         * @brief 加密若干相互独立的分组，每次交错推进8个分组以填满AES流水线
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void encrypt_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+
+        /**
+         * @brief 加密若干相互独立的分组并与输入异或：output_i = E(input_i) ^ input_i
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void encrypt_xor_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+
+        /**
+         * @brief CBC-MAC链式处理若干完整分组：state = E(state ^ block_i)
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param data 输入数据，长度为block_count * 16字节
+         * @param block_count 完整分组数
+         * @param state 16字节链状态，既是输入也是输出
+         */
+        void cbc_mac(const uint8_t *round_keys, int rounds, const uint8_t *data, size_t block_count, uint8_t *state);
+
+        /**
+         * @brief 由加密轮密钥生成等价逆密码(aesdec)使用的解密轮密钥
+         * @param round_keys 字节序加密轮密钥
+         * @param rounds 轮数
+         * @param inverse_keys 输出的解密轮密钥，共(rounds + 1) * 16字节
+         */
+        void inverse_round_keys(const uint8_t *round_keys, int rounds, uint8_t *inverse_keys);
+
+        /**
+         * @brief 解密若干相互独立的分组，每次交错推进8个分组
+         * @param inverse_keys inverse_round_keys生成的解密轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void decrypt_blocks(const uint8_t *inverse_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+    }
+}
+
+#endif // AES_NI_H
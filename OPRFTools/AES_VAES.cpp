@@ -0,0 +1,172 @@
+#include "AES_VAES.h"
+#include "AES_NI.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define AES_VAES_AVAILABLE 1
+#define AES_VAES_TARGET __attribute__((target("vaes,avx512f,aes")))
+#endif
+
+namespace OPRFTools
+{
+    namespace AES_VAES
+    {
+#ifdef AES_VAES_AVAILABLE
+        // 宽内核的工作模式
+        enum class Mode
+        {
+            Encrypt,    // output = E(input)
+            EncryptXor, // output = E(input) ^ input (Matyas-Meyer-Oseas结构)
+            Decrypt     // output = D(input)，使用等价逆密码的解密轮密钥
+        };
+
+        // 一轮完整的加密或解密
+        template <Mode M>
+        AES_VAES_TARGET static inline __m512i aes_round(__m512i block, __m512i key)
+        {
+            if constexpr (M == Mode::Decrypt)
+            {
+                return _mm512_aesdec_epi128(block, key);
+            }
+            else
+            {
+                return _mm512_aesenc_epi128(block, key);
+            }
+        }
+
+        // 最后一轮(不含列混合)
+        template <Mode M>
+        AES_VAES_TARGET static inline __m512i aes_last_round(__m512i block, __m512i key)
+        {
+            if constexpr (M == Mode::Decrypt)
+            {
+                return _mm512_aesdeclast_epi128(block, key);
+            }
+            else
+            {
+                return _mm512_aesenclast_epi128(block, key);
+            }
+        }
+
+        /**
+         * @brief 对一个512位寄存器中的4个分组执行AES加密或解密
+         * @param rk 广播到4个128位通道的轮密钥
+         * @param rounds 轮数
+         * @param block 待处理的4个分组
+         * @return 处理后的4个分组
+         */
+        template <Mode M>
+        AES_VAES_TARGET static inline __m512i process_x4(const __m512i *rk, int rounds, __m512i block)
+        {
+            block = _mm512_xor_si512(block, rk[0]);
+            for (int round = 1; round < rounds; ++round)
+            {
+                block = aes_round<M>(block, rk[round]);
+            }
+            return aes_last_round<M>(block, rk[rounds]);
+        }
+
+        /**
+         * @brief 宽内核主体
+         * @tparam M 工作模式
+         */
+        template <Mode M>
+        AES_VAES_TARGET static void process_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            // 使用全掩码的maskz版本广播：非掩码版本在GCC头文件中以未定义值作为合并源，会触发误报警告
+            __m512i rk[15];
+            for (int i = 0; i <= rounds; ++i)
+            {
+                rk[i] = _mm512_maskz_broadcast_i32x4(static_cast<__mmask16>(0xffff), _mm_loadu_si128(reinterpret_cast<const __m128i *>(round_keys + 16 * i)));
+            }
+
+            size_t i = 0;
+            // 每次推进4个寄存器共16个分组，轮间无数据依赖
+            for (; i + 16 <= block_count; i += 16)
+            {
+                __m512i x[4];
+                __m512i b[4];
+                for (int j = 0; j < 4; ++j)
+                {
+                    x[j] = _mm512_loadu_si512(input + 16 * (i + 4 * j));
+                    b[j] = _mm512_xor_si512(x[j], rk[0]);
+                }
+                for (int round = 1; round < rounds; ++round)
+                {
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        b[j] = aes_round<M>(b[j], rk[round]);
+                    }
+                }
+                for (int j = 0; j < 4; ++j)
+                {
+                    b[j] = aes_last_round<M>(b[j], rk[rounds]);
+                    if constexpr (M == Mode::EncryptXor)
+                    {
+                        b[j] = _mm512_xor_si512(b[j], x[j]);
+                    }
+                    _mm512_storeu_si512(output + 16 * (i + 4 * j), b[j]);
+                }
+            }
+
+            // 尾部不足16个分组：按4个一组用掩码读写，越界部分不访问内存
+            for (; i < block_count; i += 4)
+            {
+                size_t n = block_count - i < 4 ? block_count - i : 4;
+                __mmask8 mask = static_cast<__mmask8>((1u << (2 * n)) - 1);
+                __m512i x = _mm512_maskz_loadu_epi64(mask, input + 16 * i);
+                __m512i b = process_x4<M>(rk, rounds, x);
+                if constexpr (M == Mode::EncryptXor)
+                {
+                    b = _mm512_xor_si512(b, x);
+                }
+                _mm512_mask_storeu_epi64(output + 16 * i, mask, b);
+            }
+        }
+
+        bool supported()
+        {
+            // 只检测一次，结果在进程生命周期内不变
+            static const bool has_vaes = []
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("vaes") && __builtin_cpu_supports("avx512f") && AES_NI::supported();
+            }();
+            return has_vaes;
+        }
+
+        void encrypt_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            process_blocks<Mode::Encrypt>(round_keys, rounds, input, output, block_count);
+        }
+
+        void encrypt_xor_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            process_blocks<Mode::EncryptXor>(round_keys, rounds, input, output, block_count);
+        }
+
+        void decrypt_blocks(const uint8_t *inverse_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count)
+        {
+            process_blocks<Mode::Decrypt>(inverse_keys, rounds, input, output, block_count);
+        }
+#else
+        // 非x86-64平台：内核不可用，调用方应回退到其他实现
+        bool supported()
+        {
+            return false;
+        }
+
+        void encrypt_blocks(const uint8_t *, int, const uint8_t *, uint8_t *, size_t)
+        {
+        }
+
+        void encrypt_xor_blocks(const uint8_t *, int, const uint8_t *, uint8_t *, size_t)
+        {
+        }
+
+        void decrypt_blocks(const uint8_t *, int, const uint8_t *, uint8_t *, size_t)
+        {
+        }
+#endif
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef AES_VAES_H
+#define AES_VAES_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace OPRFTools
+{
+    // 基于VAES + AVX-512的宽AES内核(Ice Lake及之后的x86-64)
+    // 一条指令对512位寄存器中的4个分组同时执行一轮AES，每次循环推进16个分组。
+    // 轮数与轮密钥的约定与AES_NI内核相同：共rounds + 1个16字节轮密钥。
+    namespace AES_VAES
+    {
+        /**
+         * @brief 运行时检测当前CPU是否支持VAES与AVX-512F(以及AES-NI)
+         * @return true：可以使用本内核
+         */
+        bool supported();
+
+        /**
+         * @brief 加密若干相互独立的分组
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void encrypt_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+
+        /**
+         * @brief 加密若干相互独立的分组并与输入异或：output_i = E(input_i) ^ input_i
+         * @param round_keys 字节序轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void encrypt_xor_blocks(const uint8_t *round_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+
+        /**
+         * @brief 解密若干相互独立的分组
+         * @param inverse_keys AES_NI::inverse_round_keys生成的解密轮密钥
+         * @param rounds 轮数
+         * @param input 输入分组，长度为block_count * 16字节
+         * @param output 输出分组，可与input相同
+         * @param block_count 分组数
+         */
+        void decrypt_blocks(const uint8_t *inverse_keys, int rounds, const uint8_t *input, uint8_t *output, size_t block_count);
+    }
+}
+
+#endif // AES_VAES_H
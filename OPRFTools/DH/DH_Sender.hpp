@@ -5,13 +5,13 @@
 #include "../../SocketTools/Client_Sender.hpp"
 #include "../../SocketTools/Server_Receiver.hpp"
 #include "../PRF_AES.h"
-#include "../../HashTools/SHA_Family/SHA256.hpp"
 #include <vector>
 #include <string>
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
 #include <stdexcept>
+#include <algorithm>
 #include <chrono>
 #include <random>
 #include <iomanip>
@@ -86,23 +86,19 @@ namespace OPRFTools
         }
 
         /**
-         * 打印单个OPRF运算结果并返回格式化后的输出字符串
+         * 打印单个OPRF运算结果
          * @param input OPRF运算的输入字符串
-         * @param output OPRF运算的输出字节序列
+         * @param output OPRF运算的16字节输出
          * @param index OPRF运算结果的索引号，用于标识第几个运算结果
-         * @return 格式化后的OPRF输出字符串（十六进制表示）
          */
-        std::string printSingleOprfResult(const std::string &input, const std::string &output, size_t index) const
+        void printSingleOprfResult(const std::string &input, const PRF_AES::Output &output, size_t index) const
         {
             std::cout << "OPRF输入 " << index << ": " << input << std::endl;
+            // 将输出字节序列一次性编码为十六进制表示
+            char hex[2 * sizeof(PRF_AES::Output)];
+            CryptoTools::HexCodec::encode(output.data(), output.size(), hex);
             std::cout << "OPRF输出 " << index << ": ";
-            std::string str = "";
-            // 将输出字节序列转换为十六进制字符串表示
-            for (unsigned char byte : output)
-            {
-                str += byteToHexString(byte);
-            }
-            return str;
+            std::cout.write(hex, sizeof(hex)) << std::endl;
         }
 
     public:
@@ -127,10 +123,10 @@ namespace OPRFTools
          * 5. 使用共享密钥作为PRF密钥，对输入数据集进行OPRF计算
          *
          * @param datasets 输入的数据集，每个元素为待计算OPRF的字符串
-         * @return std::vector<std::string> 返回每条输入数据对应的OPRF计算结果字符串，
+         * @return std::vector<PRF_AES::Output> 返回每条输入数据对应的16字节OPRF结果，
          *         若执行过程中出现错误则返回空向量
          */
-        std::vector<std::string> run(const std::vector<std::string> &datasets)
+        std::vector<PRF_AES::Output> run(const std::vector<std::string> &datasets)
         {
             try
             {
@@ -222,9 +218,7 @@ namespace OPRFTools
 
                 // 步骤5：使用共享密钥生成PRF密钥，并对数据集执行OPRF计算
                 std::cout << "===== 步骤5/5：计算OPRF结果 =====" << std::endl;
-                SHA256 sha256;
-                sha256.input(std::to_string(shared_secret));
-                std::string prf_key = sha256.output(32);
+                std::string prf_key = derive_prf_key(shared_secret);
 
                 if (prf_key.size() != 32)
                 {
@@ -232,21 +226,20 @@ namespace OPRFTools
                 }
 
                 PRF_AES prf(prf_key);
-                std::vector<std::string> oprf_outputs;
-
-                for (size_t i = 0; i < datasets.size(); ++i)
-                {
-                    const std::string &input = datasets[i];
-                    std::string output = prf.evaluate(input);
 
-                    if (output.empty())
-                    {
-                        throw std::runtime_error("第" + std::to_string(i + 1) + "条数据OPRF计算失败，输入=" + input);
-                    }
+                // 多线程并行计算全部输入的PRF值，结果按输入顺序写入定长数组
+                std::vector<PRF_AES::Output> oprf_outputs(datasets.size());
+                prf.evaluate_parallel(datasets, oprf_outputs);
 
-                    std::string res = printSingleOprfResult(input, output, i + 1);
-                    std::cout << res << std::endl;
-                    oprf_outputs.push_back(res);
+                // 计算完成后统一输出，只打印前若干条结果
+                size_t printed = std::min(datasets.size(), MAX_PRINTED_RESULTS);
+                for (size_t i = 0; i < printed; ++i)
+                {
+                    printSingleOprfResult(datasets[i], oprf_outputs[i], i + 1);
+                }
+                if (printed < datasets.size())
+                {
+                    std::cout << "... 共" << datasets.size() << "条OPRF结果，仅显示前" << printed << "条" << std::endl;
                 }
 
                 std::cout << "===== 发送方流程全部完成 =====" << std::endl;
@@ -7,12 +7,27 @@
 #include <cmath>
 #include <vector>
 #include <iomanip> // 用于setw、setfill等格式化操作
+#include <string>
+#include "../../HashTools/SHA_Family/HMAC_SHA256.hpp"
+#include "../../CryptoTools/HexCodec.hpp"
 
 // 与接收方统一的端口常量（确保两端端口一致）
 const int PARAM_PORT = 8080;
 const int PUBLIC_KEY_PORT = 8081;
 const int MIN_PRIME = 10000;
 const int MAX_PRIME = 50000;
+// OPRF结果最多打印的条数(大数据集只打印前若干条，避免终端输出拖慢计算)
+const size_t MAX_PRINTED_RESULTS = 10;
+// 从共享密钥派生PRF密钥时使用的HKDF上下文信息(两端必须一致)
+const char *const PRF_KEY_INFO = "CryptoMagic DH-OPRF PRF key";
+
+// 使用HKDF-SHA256从DH共享密钥派生32字节PRF密钥(AES-256)
+// 需要为分桶、会话等派生更多子密钥时，复用同一个HKDF_SHA256对象并更换info即可
+inline std::string derive_prf_key(long long shared_secret)
+{
+    HKDF_SHA256 hkdf("", std::to_string(shared_secret));
+    return hkdf.expand_string(PRF_KEY_INFO, 32);
+}
 // 大整数模幂运算: (base^exponent) % mod
 // 使用快速幂算法提高效率
 inline long long mod_pow(long long base, long long exponent, long long mod)
@@ -135,15 +150,4 @@ inline long long compute_shared_secret(long long received_public, long long priv
 {
     return mod_pow(received_public, private_key, p);
 }
-// 将单个字节转换为两位十六进制字符串（例如：0x0a -> "0a"，0xab -> "ab"）
-std::string byteToHexString(unsigned char byte)
-{
-    std::stringstream ss;
-    // 设置十六进制格式，宽度为2，不足补0，然后写入字节的整数形式
-    ss << std::hex
-       << std::setw(2)
-       << std::setfill('0')
-       << static_cast<int>(byte);
-    return ss.str(); // 返回格式化后的字符串
-}
 #endif // COMMON_H
@@ -0,0 +1,94 @@
+#include "FixedKeyAESHash.h"
+#include <stdexcept>
+#include <string>
+
+// 内置公开密钥：圆周率小数部分的前128位(0x243F6A88 85A308D3 13198A2E 03707344)
+static const uint8_t DEFAULT_KEY[16] = {
+    0x24, 0x3f, 0x6a, 0x88, 0x85, 0xa3, 0x08, 0xd3,
+    0x13, 0x19, 0x8a, 0x2e, 0x03, 0x70, 0x73, 0x44};
+
+/**
+ * @brief 在扩展密钥之前校验后端
+ * @param key 16字节AES-128密钥
+ * @param backend 加密后端
+ * @return key
+ * @throws std::invalid_argument 当后端不被当前CPU支持时抛出异常
+ */
+static const uint8_t *checked_key(const uint8_t *key, PRF_AES::Backend backend)
+{
+    if (!PRF_AES::backend_supported(backend))
+    {
+        throw std::invalid_argument(std::string("当前CPU不支持FixedKeyAESHash后端: ") + PRF_AES::backend_name(backend));
+    }
+    return key;
+}
+
+/**
+ * @brief 使用内置公开密钥构造，自动选择当前CPU上最快的后端
+ */
+FixedKeyAESHash::FixedKeyAESHash() : FixedKeyAESHash(DEFAULT_KEY, PRF_AES::detect_backend())
+{
+}
+
+/**
+ * @brief 使用指定公开密钥和后端构造，标准AES-128密钥扩展由AESCore完成
+ *
+ * @param key 16字节AES-128密钥(公开参数，双方需一致)
+ * @param backend 加密后端
+ * @throws std::invalid_argument 当后端不被当前CPU支持时抛出异常
+ */
+FixedKeyAESHash::FixedKeyAESHash(const uint8_t *key, PRF_AES::Backend backend) : core_(checked_key(key, backend), 16, backend)
+{
+}
+
+/**
+ * @brief 计算单个分组的哈希
+ * @param input 128位输入
+ * @return π(input) ⊕ input
+ */
+FixedKeyAESHash::Block FixedKeyAESHash::hash(const Block &input) const
+{
+    Block output;
+    hash_batch(&input, &output, 1);
+    return output;
+}
+
+/**
+ * @brief 批量计算哈希
+ *
+ * 硬件后端在一个内核中完成加密与异或，AES-NI每次交错推进8个分组，VAES每次推进16个分组；
+ * 位切片后端按块加密到临时缓冲区后再与输入异或。
+ *
+ * @param input 输入分组数组
+ * @param output 输出分组数组，可与input相同
+ * @param count 分组数
+ */
+void FixedKeyAESHash::hash_batch(const Block *input, Block *output, size_t count) const
+{
+    static_assert(sizeof(Block) == 16, "FixedKeyAESHash::Block必须是紧凑的16字节");
+    core_.encrypt_xor_blocks(reinterpret_cast<const uint8_t *>(input), reinterpret_cast<uint8_t *>(output), count);
+}
+
+/**
+ * @brief 批量计算哈希
+ * @param inputs 输入分组序列
+ * @param outputs 输出分组序列，长度必须与inputs相同，可与inputs为同一序列
+ * @throws std::invalid_argument 当输出序列长度与输入不一致时抛出异常
+ */
+void FixedKeyAESHash::hash_batch(std::span<const Block> inputs, std::span<Block> outputs) const
+{
+    if (outputs.size() != inputs.size())
+    {
+        throw std::invalid_argument("FixedKeyAESHash批量输出数量必须与输入数量一致");
+    }
+    hash_batch(inputs.data(), outputs.data(), inputs.size());
+}
+
+/**
+ * @brief 原地批量计算哈希
+ * @param blocks 分组序列，结果原地写回
+ */
+void FixedKeyAESHash::hash_batch(std::span<Block> blocks) const
+{
+    hash_batch(blocks.data(), blocks.data(), blocks.size());
+}
@@ -0,0 +1,44 @@
+#ifndef FIXED_KEY_AES_HASH_H
+#define FIXED_KEY_AES_HASH_H
+
+#include "PRF_AES.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+// 基于固定密钥AES的128位相关鲁棒哈希：H(x) = π(x) ⊕ x (Matyas-Meyer-Oseas结构)
+// π为公开固定密钥下的标准AES-128置换。密钥只在构造时扩展一次，之后每个分组只需一次AES，
+// 适合对OPRF输出等已经均匀分布的128位值做快速“随机预言”式哈希(如写入布隆过滤器前)。
+class FixedKeyAESHash
+{
+public:
+    // 128位分组类型，与PRF_AES的输出类型一致
+    using Block = PRF_AES::Output;
+
+    // 使用内置的公开固定密钥(圆周率小数部分的前128位)，自动选择最快后端
+    FixedKeyAESHash();
+
+    // 使用指定的16字节公开密钥和后端(后端不被当前CPU支持时抛出异常)
+    FixedKeyAESHash(const uint8_t *key, PRF_AES::Backend backend);
+
+    // 计算单个分组的哈希
+    Block hash(const Block &input) const;
+
+    // 批量计算哈希：output[i] = π(input[i]) ⊕ input[i]，output可与input相同
+    void hash_batch(const Block *input, Block *output, size_t count) const;
+
+    // 批量计算哈希(outputs.size()必须等于inputs.size())
+    void hash_batch(std::span<const Block> inputs, std::span<Block> outputs) const;
+
+    // 原地批量计算哈希
+    void hash_batch(std::span<Block> blocks) const;
+
+    // 获取当前使用的后端
+    PRF_AES::Backend backend() const { return core_.backend(); }
+
+private:
+    // 标准AES-128引擎(10轮)，由各后端共用的AESCore实现
+    OPRFTools::AESCore core_;
+};
+
+#endif // FIXED_KEY_AES_HASH_H
@@ -1,379 +1,614 @@
 #include "PRF_AES.h"
+#include "../HashTools/SHA_Family/HMAC_SHA256.hpp"
 #include <cstring>
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
 
-// AES轮常量
-static const uint8_t RCON[11] = {0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+// PRF的分组变换轮数
+/**
+ * @brief 计算PRF_AES的分组变换需要执行的轮数
+ *
+ * PRF_AES的分组变换共执行rounds-1轮，最后一轮(不含列混合)使用第rounds-1个轮密钥，
+ * 即PRF_AES_Fixed::CIPHER_ROUNDS。各后端按同样的轮数执行，保证输出逐位一致。
+ *
+ * @param key_len 密钥长度(字节)
+ * @return 分组变换的轮数
+ */
+static int prf_rounds(size_t key_len)
+{
+    return static_cast<int>(key_len / 4) + 6 - 1;
+}
+
+// 校验构造参数
+/**
+ * @brief 在扩展密钥之前校验后端与密钥长度
+ * @param key AES密钥字符串
+ * @param backend 加密后端
+ * @return 指向密钥字节的指针
+ * @throws std::invalid_argument 当后端不被当前CPU支持或密钥长度不符合AES标准时抛出异常
+ */
+static const uint8_t *checked_key(const std::string &key, PRF_AES::Backend backend)
+{
+    if (!PRF_AES::backend_supported(backend))
+    {
+        throw std::invalid_argument(std::string("当前CPU不支持PRF_AES后端: ") + PRF_AES::backend_name(backend));
+    }
+
+    // 验证AES密钥长度是否符合标准要求
+    if (key.size() != 16 && key.size() != 24 && key.size() != 32)
+    {
+        throw std::invalid_argument("AES密钥长度必须是16字节(128位)、24字节(192位)或32字节(256位)");
+    }
+    return reinterpret_cast<const uint8_t *>(key.data());
+}
 
-// 字节替换
+// 派生宽输出扩展引擎
 /**
- * @brief 对输入的字节进行S盒替换，用于AES加密算法中的SubBytes步骤。
+ * @brief 以HKDF-SHA256从PRF密钥派生同长度的扩展密钥K_w，并在同一后端上扩展
  *
- * 该函数使用预定义的S盒（Substitution Box）对输入字节进行非线性替换。
- * S盒是AES算法中关键的安全组件，用于提供混淆特性。
+ * 扩展分组若仍在K下加密，E_K(T ^ i)恰好是evaluate(x || i)的结果，
+ * 能查询evaluate的一方即可得到全部宽输出。K_w经HMAC派生，无法通过evaluate获得。
  *
- * @param byte 输入的8位无符号整数（字节）
- * @return 经过S盒替换后的8位无符号整数
+ * @param key AES密钥字符串(已由checked_key校验)
+ * @param backend 加密后端
+ * @return 扩展密钥对应的AES引擎
+ */
+static OPRFTools::AESCore wide_core(const std::string &key, PRF_AES::Backend backend)
+{
+    uint8_t wide_key[32];
+    HKDF_SHA256("", key).expand("PRF_AES evaluate_wide", std::span<uint8_t>(wide_key, key.size()));
+    OPRFTools::AESCore core(wide_key, key.size(), backend, prf_rounds(key.size()));
+    std::fill(std::begin(wide_key), std::end(wide_key), 0);
+    return core;
+}
+// 构造函数
+/**
+ * @brief PRF_AES类的构造函数，用于初始化AES伪随机函数
+ *
+ * 该构造函数接收一个字符串形式的密钥，验证其长度是否符合AES标准，
+ * 并在当前CPU上最快的后端上扩展密钥。
+ *
+ * @param key AES密钥字符串，长度必须为16字节(128位)、24字节(192位)或32字节(256位)
+ *
+ * @throws std::invalid_argument 当密钥长度不符合AES标准时抛出异常
  */
-static uint8_t sub_byte(uint8_t byte)
+PRF_AES::PRF_AES(const std::string &key) : PRF_AES(key, detect_backend())
 {
-    // S盒：AES算法中使用的256字节查找表，用于字节替换
-    static const uint8_t sbox[256] = {
-        0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
-        0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
-        0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-        0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
-        0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
-        0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-        0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
-        0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
-        0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-        0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
-        0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
-        0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-        0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
-        0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
-        0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-        0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
-
-    // 使用输入字节作为索引，从S盒中获取替换值
-    return sbox[byte];
 }
 
-// 行移位
+// 构造函数(指定后端)
 /**
- * @brief 对状态矩阵进行行移位操作
+ * @brief PRF_AES类的构造函数，使用指定的加密后端
  *
- * 该函数实现AES加密算法中的ShiftRows步骤，对状态矩阵的每一行进行循环左移：
- * - 第一行不移动
- * - 第二行循环左移1位
- * - 第三行循环左移2位
- * - 第四行循环左移3位
+ * 不同后端的输出逐位一致，指定后端主要用于对比测试和性能评估。
  *
- * @param state 指向状态矩阵的指针，包含16个字节元素
+ * @param key AES密钥字符串，长度必须为16字节(128位)、24字节(192位)或32字节(256位)
+ * @param backend 加密后端
+ *
+ * @throws std::invalid_argument 当密钥长度不符合AES标准或后端不被当前CPU支持时抛出异常
  */
-static void shift_rows(uint8_t *state)
+PRF_AES::PRF_AES(const std::string &key, Backend backend)
+    : key_(key), key_len_(key.size()), engine_(checked_key(key, backend), key.size(), backend, prf_rounds(key.size())),
+      wide_engine_(wide_core(key, backend))
 {
-    // 第二行左移1位
-    std::swap(state[1], state[5]);
-    std::swap(state[5], state[9]);
-    std::swap(state[9], state[13]);
-
-    // 第三行左移2位
-    std::swap(state[2], state[10]);
-    std::swap(state[6], state[14]);
-
-    // 第四行左移3位
-    std::swap(state[15], state[11]);
-    std::swap(state[11], state[7]);
-    std::swap(state[7], state[3]);
 }
 
-// 列混合
+// 内部复制构造函数
 /**
- * @brief 对AES算法的状态矩阵进行列混合操作
+ * @brief 复制另一个实例的轮密钥与后端选择，得到可独立使用的实例
  *
- * 该函数实现AES加密算法中的MixColumns步骤，对状态矩阵的每一列进行线性变换。
- * 变换使用固定的多项式乘法矩阵与状态列进行伽罗瓦域(GF(2^8))上的矩阵乘法。
+ * 仅供并行计算内部使用：每个工作线程持有一份自己的轮密钥副本，
+ * 副本由工作线程自己创建，位于本核的栈和缓存上，线程之间不共享可写状态。
+ * 原始密钥字符串不会被复制。
  *
- * @param state 指向包含16字节状态矩阵的数组指针，按列优先顺序存储
- *              函数执行后，原数组内容将被变换后的结果覆盖
+ * @param other 被复制的实例
  */
-static void mix_columns(uint8_t *state)
+PRF_AES::PRF_AES(const PRF_AES &other, CloneTag)
+    : key_len_(other.key_len_), engine_(other.engine_), wide_engine_(other.wide_engine_)
 {
-    /**
-     * @brief 在GF(2^8)域上执行两个字节的乘法运算
-     *
-     * 使用标准的多项式 x^8 + x^4 + x^3 + x + 1 (0x11b) 进行模约简
-     * 实现了有限域上的乘法操作，用于MixColumns变换
-     *
-     * @param a 被乘数
-     * @param b 乘数
-     * @return 两个输入参数在GF(2^8)域上的乘积结果
-     */
-    auto gmul = [](uint8_t a, uint8_t b)
-    {
-        uint8_t p = 0;
-        for (int i = 0; i < 8; ++i)
-        {
-            if (b & 1)
-                p ^= a;
-            bool hi = a & 0x80;
-            a <<= 1;
-            if (hi)
-                a ^= 0x1b; // 多项式x^8 + x^4 + x^3 + x + 1
-            b >>= 1;
-        }
-        return p;
-    };
+}
 
-    // 对状态矩阵的每一列应用MixColumns变换
-    for (int i = 0; i < 4; ++i)
-    {
-        int col = i * 4;
-        uint8_t s0 = state[col];
-        uint8_t s1 = state[col + 1];
-        uint8_t s2 = state[col + 2];
-        uint8_t s3 = state[col + 3];
-
-        // 根据AES标准的MixColumns矩阵进行线性变换
-        state[col] = gmul(s0, 2) ^ gmul(s1, 3) ^ s2 ^ s3;
-        state[col + 1] = s0 ^ gmul(s1, 2) ^ gmul(s2, 3) ^ s3;
-        state[col + 2] = s0 ^ s1 ^ gmul(s2, 2) ^ gmul(s3, 3);
-        state[col + 3] = gmul(s0, 3) ^ s1 ^ s2 ^ gmul(s3, 2);
-    }
+// 析构函数，清除敏感数据
+/**
+ * @brief PRF_AES析构函数
+ * @details 负责清理AES加密相关的密钥数据，防止敏感信息在内存中残留
+ *          当对象被销毁时，会自动清除存储在key_和轮密钥中的数据
+ */
+PRF_AES::~PRF_AES()
+{
+    // 清除密钥，轮密钥由AESCore析构时清除
+    std::fill(key_.begin(), key_.end(), 0);
+}
+
+// 检测可用的最快后端
+/**
+ * @brief 通过CPUID检测当前CPU上可用的最快后端，由AESCore统一判断
+ * @return 支持VAES + AVX-512时返回Backend::VAES，仅支持AES-NI时返回Backend::AESNI，
+ *         否则返回Backend::Bitslice
+ */
+PRF_AES::Backend PRF_AES::detect_backend()
+{
+    return OPRFTools::AESCore::detect_backend();
+}
+
+// 判断后端是否可用
+/**
+ * @brief 判断指定后端在当前CPU上是否可用
+ * @param backend 待检测的后端
+ * @return true：可用；false：不可用
+ */
+bool PRF_AES::backend_supported(Backend backend)
+{
+    return OPRFTools::AESCore::backend_supported(backend);
+}
+
+// 获取后端名称
+/**
+ * @brief 获取后端的可读名称
+ * @param backend 后端
+ * @return 后端名称字符串
+ */
+const char *PRF_AES::backend_name(Backend backend)
+{
+    return OPRFTools::AESCore::backend_name(backend);
 }
 
-// 密钥扩展
+// 计算PRF(key, input)，输入为字符串
 /**
- * @brief AES密钥扩展函数，根据原始密钥生成每轮加密所需的轮密钥
+ * @brief 伪随机函数评估接口，使用AES算法对输入字符串进行处理
  *
- * 该函数根据AES标准实现密钥扩展算法，支持128位、192位和256位密钥长度。
- * 扩展后的轮密钥存储在round_keys数组中，轮数存储在rounds变量中。
+ * 该函数作为PRF_AES类的核心接口，将输入的字符串转换为字节序列，
+ * 并调用底层的字节序列处理函数进行伪随机函数评估。
  *
- * @param key 指向原始密钥数据的指针
- * @param key_len 原始密钥的长度（单位：字节），必须为16、24或32
- * @param round_keys 指向存储扩展后轮密钥的数组的指针
- * @param rounds 引用变量，用于返回所需的加密轮数
- * @throws std::invalid_argument 当密钥长度不是16、24或32字节时抛出异常
+ * @param input 输入的字符串数据，将被转换为字节序列进行处理
+ * @return std::string 返回经过AES伪随机函数处理后的结果字符串
  */
-static void key_expansion(const uint8_t *key, size_t key_len, uint32_t *round_keys, int &rounds)
+std::string PRF_AES::evaluate(const std::string &input)
 {
-    // 根据密钥长度确定轮数
-    if (key_len == 16)
-        rounds = 10; // 128位密钥
-    else if (key_len == 24)
-        rounds = 12; // 192位密钥
-    else if (key_len == 32)
-        rounds = 14; // 256位密钥
-    else
-        throw std::invalid_argument("无效的AES密钥长度，必须是16、24或32字节");
-
-    // 初始化轮密钥
-    int n = key_len / 4; // 密钥字数(4字节为1字)
-    int total_words = (rounds + 1) * 4;
-
-    // 复制原始密钥到轮密钥
-    for (int i = 0; i < n; ++i)
-    {
-        round_keys[i] = (key[4 * i] << 24) | (key[4 * i + 1] << 16) | (key[4 * i + 2] << 8) | key[4 * i + 3];
-    }
+    // 将输入字符串转换为字节指针并调用底层评估函数
+    return evaluate(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+}
 
-    // 生成剩余轮密钥
-    for (int i = n; i < total_words; ++i)
-    {
-        uint32_t temp = round_keys[i - 1];
+// 计算PRF(key, input)，输入为字节数组
+/**
+ * @brief 使用AES实现的伪随机函数(PRF)，对输入数据进行处理并返回16字节的输出
+ *
+ * 字符串返回值需要一次堆分配，对性能敏感的调用方应使用写入Output的重载。
+ *
+ * @param input 指向输入数据的指针
+ * @param input_len 输入数据的长度(字节数)
+ * @return std::string 包含16字节PRF输出结果的字符串
+ */
+std::string PRF_AES::evaluate(const uint8_t *input, size_t input_len)
+{
+    uint8_t block[16];
+    evaluate_into(input, input_len, block);
+    return std::string(reinterpret_cast<char *>(block), 16); // reinterpret_cast 转换为字符串
+}
 
-        if (i % n == 0)
-        {
-            // RotWord和SubWord变换
-            temp = ((temp << 8) | (temp >> 24)) & 0xFFFFFFFF;
-            uint8_t *p = reinterpret_cast<uint8_t *>(&temp);
-            p[0] = sub_byte(p[0]);
-            p[1] = sub_byte(p[1]);
-            p[2] = sub_byte(p[2]);
-            p[3] = sub_byte(p[3]);
-
-            // Rcon异或
-            temp ^= (RCON[i / n] << 24);
-        }
-        // 256位密钥额外处理
-        else if (n > 6 && i % n == 4)
-        {
-            uint8_t *p = reinterpret_cast<uint8_t *>(&temp);
-            p[0] = sub_byte(p[0]);
-            p[1] = sub_byte(p[1]);
-            p[2] = sub_byte(p[2]);
-            p[3] = sub_byte(p[3]);
-        }
+// 计算PRF(key, input)，结果写入定长数组
+/**
+ * @brief 计算字符串输入的PRF值，结果写入定长数组，不产生堆分配
+ *
+ * @param input 输入的字符串数据
+ * @param output 16字节输出数组
+ */
+void PRF_AES::evaluate(const std::string &input, Output &output)
+{
+    evaluate_into(reinterpret_cast<const uint8_t *>(input.data()), input.size(), output.data());
+}
 
-        round_keys[i] = round_keys[i - n] ^ temp;
+// 计算PRF(key, input)，结果写入定长数组
+/**
+ * @brief 计算字节数组输入的PRF值，结果写入定长数组，不产生堆分配
+ *
+ * @param input 指向输入数据的指针
+ * @param input_len 输入数据的长度(字节数)
+ * @param output 16字节输出数组
+ */
+void PRF_AES::evaluate(const uint8_t *input, size_t input_len, Output &output)
+{
+    evaluate_into(input, input_len, output.data());
+}
+
+// 计算PRF(key, input)，结果写入调用方缓冲区
+/**
+ * @brief 计算字节数组输入的PRF值，结果写入调用方提供的缓冲区前16字节
+ *
+ * @param input 指向输入数据的指针
+ * @param input_len 输入数据的长度(字节数)
+ * @param output 输出缓冲区，长度至少16字节
+ * @throws std::invalid_argument 当输出缓冲区不足16字节时抛出异常
+ */
+void PRF_AES::evaluate(const uint8_t *input, size_t input_len, std::span<uint8_t> output)
+{
+    if (output.size() < 16)
+    {
+        throw std::invalid_argument("PRF输出缓冲区长度不足16字节");
     }
+    evaluate_into(input, input_len, output.data());
 }
 
-// 轮密钥加
+// 宽输出模式
 /**
- * @brief 将轮密钥与状态矩阵进行异或运算
+ * @brief 计算PRF标签后按计数器模式扩展到任意长度
  *
- * 该函数实现AES加密算法中的轮密钥加步骤，将指定轮次的轮密钥
- * 与当前状态矩阵进行逐字节异或运算
+ * 整条输入的CBC-MAC只计算一次得到T，扩展块E_{K_w}(T ^ i)之间相互独立，
+ * 通过AESCore::encrypt_blocks批量加密，硬件后端可以同时推进多个分组。
+ * 扩展使用独立派生的密钥K_w，因此T本身不出现在输出中，
+ * 宽输出也不会与任何evaluate调用(包括对x || i的调用)的结果重合。
+ * 需要多个布谷鸟位置加标签、或需要派生密钥材料时，一次调用即可得到全部输出，
+ * 无需对调整过的输入重复运行整条CBC-MAC链。
  *
- * @param state 指向状态矩阵的指针，包含16个字节的数据
- * @param round_keys 指向所有轮密钥的指针，每轮包含4个32位字
- * @param round 当前轮次索引，用于定位对应的轮密钥
+ * @param input 指向输入数据的指针
+ * @param input_len 输入数据的长度(字节数)
+ * @param output 输出缓冲区，写满output.size()字节
  */
-static void add_round_key(uint8_t *state, const uint32_t *round_keys, int round)
+void PRF_AES::evaluate_wide(const uint8_t *input, size_t input_len, std::span<uint8_t> output)
 {
-    // 获取当前轮次的轮密钥起始位置
-    const uint32_t *rk = &round_keys[round * 4];
+    // 每次批量加密的计数器分组数
+    constexpr size_t EXPAND_BLOCKS = 16;
 
-    // 对状态矩阵的每一列进行轮密钥异或运算
-    for (int i = 0; i < 4; ++i)
+    uint8_t tag[16];
+    evaluate_into(input, input_len, tag);
+
+    alignas(16) uint8_t blocks[EXPAND_BLOCKS * 16];
+    uint64_t counter = 0;
+    for (size_t pos = 0; pos < output.size();)
     {
-        uint32_t word = rk[i];
-        state[i * 4] ^= (word >> 24) & 0xFF;
-        state[i * 4 + 1] ^= (word >> 16) & 0xFF;
-        state[i * 4 + 2] ^= (word >> 8) & 0xFF;
-        state[i * 4 + 3] ^= word & 0xFF;
+        size_t remaining_blocks = (output.size() - pos + 15) / 16;
+        size_t count = std::min(EXPAND_BLOCKS, remaining_blocks);
+        for (size_t i = 0; i < count; ++i, ++counter)
+        {
+            // 计数器以大端形式异或进T的低8字节
+            uint8_t *block = blocks + 16 * i;
+            memcpy(block, tag, 16);
+            for (int j = 0; j < 8; ++j)
+            {
+                block[15 - j] ^= static_cast<uint8_t>(counter >> (8 * j));
+            }
+        }
+        wide_engine_.encrypt_blocks(blocks, blocks, count);
+
+        size_t take = std::min(count * 16, output.size() - pos);
+        memcpy(output.data() + pos, blocks, take);
+        pos += take;
     }
+    std::fill(std::begin(tag), std::end(tag), 0);
 }
 
-// 初始化AES上下文
+// 宽输出模式，结果以字符串返回
 /**
- * @brief 初始化AES加密上下文
- *
- * 该函数使用给定的密钥进行密钥扩展，生成AES加密所需的轮密钥
+ * @brief 计算字符串输入的宽输出PRF值
  *
- * @param key 指向密钥数据的指针
- * @param key_len 密钥的长度（以字节为单位）
+ * @param input 输入的字符串数据
+ * @param output_len 输出长度(字节数)
+ * @return std::string 包含output_len字节输出的字符串
  */
-void PRF_AES::aes_init(const uint8_t *key, size_t key_len)
+std::string PRF_AES::evaluate_wide(const std::string &input, size_t output_len)
 {
-    // 执行密钥扩展，生成轮密钥并存储到上下文结构中
-    key_expansion(key, key_len, ctx_.round_keys, ctx_.rounds);
+    std::string output(output_len, '\0');
+    evaluate_wide(reinterpret_cast<const uint8_t *>(input.data()), input.size(),
+                  std::span<uint8_t>(reinterpret_cast<uint8_t *>(output.data()), output.size()));
+    return output;
 }
 
-// AES加密单块数据
+// 计算PRF(key, input)的核心实现
 /**
- * @brief 使用AES算法加密16字节数据块
+ * @brief 使用CBC-MAC处理变长输入，将16字节PRF结果写入output
  *
- * 该函数实现AES加密算法的核心流程，包括初始轮密钥加、多轮加密变换以及最终轮处理。
- * 加密过程遵循AES标准的四步变换：字节替换、行移位、列混合和轮密钥加。
+ * 对于完整块采用标准CBC模式处理，对于最后一个不完整块采用特定填充方案处理。
  *
- * @param input 指向16字节输入明文数据的指针
- * @param output 指向16字节输出密文数据的指针
+ * @param input 指向输入数据的指针
+ * @param input_len 输入数据的长度(字节数)
+ * @param output 指向16字节输出缓冲区的指针
  */
-void PRF_AES::aes_encrypt(const uint8_t *input, uint8_t *output)
+void PRF_AES::evaluate_into(const uint8_t *input, size_t input_len, uint8_t *output)
 {
-    uint8_t state[16];
-    memcpy(state, input, 16);
+    // 对于变长输入，我们使用CBC-MAC的方式处理
+    // 初始向量设为0
+    uint8_t block[16] = {0};
 
-    // 初始轮密钥加
-    add_round_key(state, ctx_.round_keys, 0);
+    // 处理完整的16字节块
+    size_t block_count = input_len / 16;
+    engine_.cbc_mac(input, block_count, block);
+    size_t pos = block_count * 16;
 
-    // 主加密循环
-    for (int round = 1; round < ctx_.rounds; ++round)
+    // 处理最后一个不完整块，使用特定填充方案
+    if (pos < input_len)
     {
-        // 字节替换
-        for (int i = 0; i < 16; ++i)
+        // 输入块与当前状态异或
+        for (size_t i = 0; i < input_len - pos; ++i)
         {
-            state[i] = sub_byte(state[i]);
+            block[i] ^= input[pos + i];
         }
 
-        // 行移位
-        shift_rows(state);
+        // 最后一个字节设置为填充长度
+        block[input_len - pos] ^= 0x80; // 填充10000000
+        engine_.encrypt_block(block, block);
+    }
+
+    memcpy(output, block, 16);
+}
 
-        // 列混合(最后一轮不执行)
-        if (round < ctx_.rounds - 1)
+// 批量计算PRF
+/**
+ * @brief 批量计算多个输入的PRF值
+ *
+ * 单个输入的CBC-MAC是严格串行的：每个分组都要等待上一个分组加密完成。
+ * 本函数每次取BATCH_LANES个输入，将它们的第j个分组放在一起加密，
+ * 使多条相互独立的链同时在AES流水线中推进。输出与逐个调用evaluate完全一致。
+ *
+ * @param inputs 输入数据集
+ * @param outputs 输出缓冲区，至少inputs.size() * 16字节，第i个结果写入outputs + 16 * i
+ */
+void PRF_AES::evaluate_batch(std::span<const std::string> inputs, uint8_t *outputs)
+{
+    // 同时推进的链数：填满VAES内核的4个512位寄存器，也是AES-NI 8路交错与位切片8路内核的整数倍
+    constexpr size_t BATCH_LANES = 16;
+
+    for (size_t base = 0; base < inputs.size(); base += BATCH_LANES)
+    {
+        size_t lanes = std::min(BATCH_LANES, inputs.size() - base);
+
+        // 每条链的状态与需要加密的分组数(不完整的最后一块也计为一个分组)
+        uint8_t state[BATCH_LANES][16] = {};
+        size_t steps[BATCH_LANES] = {};
+        size_t max_steps = 0;
+        for (size_t lane = 0; lane < lanes; ++lane)
         {
-            mix_columns(state);
+            steps[lane] = (inputs[base + lane].size() + 15) / 16;
+            max_steps = std::max(max_steps, steps[lane]);
         }
 
-        // 轮密钥加
-        add_round_key(state, ctx_.round_keys, round);
+        alignas(16) uint8_t blocks[BATCH_LANES * 16];
+        size_t active[BATCH_LANES];
+        for (size_t step = 0; step < max_steps; ++step)
+        {
+            // 收集本轮仍有分组的链，构造待加密分组
+            size_t count = 0;
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                if (step >= steps[lane])
+                {
+                    continue;
+                }
+
+                const std::string &input = inputs[base + lane];
+                const uint8_t *data = reinterpret_cast<const uint8_t *>(input.data()) + step * 16;
+                size_t take = std::min<size_t>(16, input.size() - step * 16);
+
+                uint8_t *block = blocks + count * 16;
+                memcpy(block, state[lane], 16);
+                for (size_t i = 0; i < take; ++i)
+                {
+                    block[i] ^= data[i];
+                }
+                // 与evaluate相同的填充方案
+                if (take < 16)
+                {
+                    block[take] ^= 0x80;
+                }
+                active[count++] = lane;
+            }
+
+            engine_.encrypt_blocks(blocks, blocks, count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                memcpy(state[active[i]], blocks + i * 16, 16);
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            memcpy(outputs + (base + lane) * 16, state[lane], 16);
+        }
     }
+}
 
-    memcpy(output, state, 16);
+// 批量计算PRF，结果写入定长数组序列
+/**
+ * @brief 批量计算多个输入的PRF值，结果写入定长数组序列
+ *
+ * @param inputs 输入数据集
+ * @param outputs 输出数组序列，长度必须与inputs相同
+ * @throws std::invalid_argument 当输出序列长度与输入不一致时抛出异常
+ */
+void PRF_AES::evaluate_batch(std::span<const std::string> inputs, std::span<Output> outputs)
+{
+    if (outputs.size() != inputs.size())
+    {
+        throw std::invalid_argument("PRF批量输出数量必须与输入数量一致");
+    }
+    // std::array<uint8_t, 16>无填充，序列在内存中即为连续的16字节块
+    static_assert(sizeof(Output) == 16, "PRF_AES::Output必须是紧凑的16字节");
+    evaluate_batch(inputs, reinterpret_cast<uint8_t *>(outputs.data()));
 }
 
-// 构造函数
+// 流式计算：初始化
 /**
- * @brief PRF_AES类的构造函数，用于初始化AES伪随机函数
+ * @brief 初始化流式计算状态，开始处理一条新的输入
  *
- * 该构造函数接收一个字符串形式的密钥，验证其长度是否符合AES标准，
- * 并调用aes_init函数进行AES算法的初始化。
+ * 流式接口与evaluate使用相同的CBC-MAC构造：对同一条输入，
+ * 无论被切分成多少段依次update，finalize的结果都与一次性evaluate完全一致。
  *
- * @param key AES密钥字符串，长度必须为16字节(128位)、24字节(192位)或32字节(256位)
+ * @param stream 流式计算状态
+ */
+void PRF_AES::init(StreamState &stream) const
+{
+    std::fill(std::begin(stream.chain), std::end(stream.chain), 0);
+    std::fill(std::begin(stream.buffer), std::end(stream.buffer), 0);
+    stream.buffered = 0;
+}
+
+// 流式计算：追加数据
+/**
+ * @brief 向流式计算状态追加一段输入
  *
- * @throws std::invalid_argument 当密钥长度不符合AES标准时抛出异常
+ * 先补齐上次遗留的不完整分组，再直接从调用方缓冲区处理中间的完整分组(不复制)，
+ * 最后把不足16字节的尾部暂存到状态中等待后续数据。
+ *
+ * @param stream 流式计算状态
+ * @param data 指向本段数据的指针
+ * @param data_len 本段数据长度(字节数)
  */
-PRF_AES::PRF_AES(const std::string &key) : key_(key), key_len_(key.size())
+void PRF_AES::update(StreamState &stream, const uint8_t *data, size_t data_len)
 {
-    // 验证AES密钥长度是否符合标准要求
-    if (key_len_ != 16 && key_len_ != 24 && key_len_ != 32)
+    // 补齐上次遗留的不完整分组
+    if (stream.buffered > 0)
     {
-        throw std::invalid_argument("AES密钥长度必须是16字节(128位)、24字节(192位)或32字节(256位)");
+        size_t take = std::min(data_len, 16 - stream.buffered);
+        memcpy(stream.buffer + stream.buffered, data, take);
+        stream.buffered += take;
+        data += take;
+        data_len -= take;
+
+        if (stream.buffered < 16)
+        {
+            return;
+        }
+        engine_.cbc_mac(stream.buffer, 1, stream.chain);
+        stream.buffered = 0;
     }
 
-    // 调用AES初始化函数，将字符串密钥转换为uint8_t指针并传入
-    aes_init(reinterpret_cast<const uint8_t *>(key.data()), key_len_);
+    // 中间的完整分组直接从调用方缓冲区处理
+    size_t block_count = data_len / 16;
+    engine_.cbc_mac(data, block_count, stream.chain);
+
+    // 暂存尾部
+    stream.buffered = data_len - block_count * 16;
+    memcpy(stream.buffer, data + block_count * 16, stream.buffered);
 }
 
-// 析构函数，清除敏感数据
+// 流式计算：追加字符串数据
 /**
- * @brief PRF_AES析构函数
- * @details 负责清理AES加密相关的密钥数据，防止敏感信息在内存中残留
- *          当对象被销毁时，会自动清除存储在key_和轮密钥中的数据
+ * @brief 向流式计算状态追加一段字符串输入
+ * @param stream 流式计算状态
+ * @param data 本段数据
  */
-PRF_AES::~PRF_AES()
+void PRF_AES::update(StreamState &stream, const std::string &data)
 {
-    // 清除密钥和轮密钥，防止内存中残留敏感数据
-    std::fill(key_.begin(), key_.end(), 0);
-    std::fill(std::begin(ctx_.round_keys), std::end(ctx_.round_keys), 0);
+    update(stream, reinterpret_cast<const uint8_t *>(data.data()), data.size());
 }
 
-// 计算PRF(key, input)，输入为字符串
+// 流式计算：输出结果
 /**
- * @brief 伪随机函数评估接口，使用AES算法对输入字符串进行处理
+ * @brief 结束流式计算并输出16字节PRF结果
  *
- * 该函数作为PRF_AES类的核心接口，将输入的字符串转换为字节序列，
- * 并调用底层的字节序列处理函数进行伪随机函数评估。
+ * 若有不完整的尾部分组，按evaluate相同的方案填充后加密。
+ * 调用后状态被清零，需重新init才能处理下一条输入。
  *
- * @param input 输入的字符串数据，将被转换为字节序列进行处理
- * @return std::string 返回经过AES伪随机函数处理后的结果字符串
+ * @param stream 流式计算状态
+ * @param output 16字节输出数组
  */
-std::string PRF_AES::evaluate(const std::string &input)
+void PRF_AES::finalize(StreamState &stream, Output &output)
 {
-    // 将输入字符串转换为字节指针并调用底层评估函数
-    return evaluate(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+    if (stream.buffered > 0)
+    {
+        for (size_t i = 0; i < stream.buffered; ++i)
+        {
+            stream.chain[i] ^= stream.buffer[i];
+        }
+        stream.chain[stream.buffered] ^= 0x80; // 填充10000000
+        engine_.encrypt_block(stream.chain, stream.chain);
+    }
+    memcpy(output.data(), stream.chain, 16);
+
+    // 清除中间状态
+    init(stream);
 }
 
-// 计算PRF(key, input)，输入为字节数组
+// 多线程并行计算PRF
 /**
- * @brief 使用AES实现的伪随机函数(PRF)，对输入数据进行处理并返回16字节的输出
+ * @brief 将数据集切分为固定大小的块，由多个工作线程并行计算PRF
  *
- * 该函数使用CBC-MAC模式处理变长输入数据。对于完整块采用标准CBC模式处理，
- * 对于最后一个不完整块采用特定填充方案处理。
+ * 工作线程通过原子计数器领取下一个块，块内调用evaluate_batch，
+ * 结果按下标直接写入outputs，因此输出顺序与输入顺序一致，与线程调度无关。
+ * 每个工作线程使用自己的轮密钥副本，避免多个核反复读取同一份共享数据。
+ * 工作线程中的异常会在所有线程汇合后重新抛出；线程创建失败时由已启动的线程完成剩余计算。
  *
- * @param input 指向输入数据的指针
- * @param input_len 输入数据的长度(字节数)
- * @return std::string 包含16字节PRF输出结果的字符串
+ * @param inputs 输入数据集
+ * @param outputs 输出数组序列，长度必须与inputs相同
+ * @param threads 线程数，为0时使用std::thread::hardware_concurrency()
+ * @throws std::invalid_argument 当输出序列长度与输入不一致时抛出异常
  */
-std::string PRF_AES::evaluate(const uint8_t *input, size_t input_len)
+void PRF_AES::evaluate_parallel(std::span<const std::string> inputs, std::span<Output> outputs, unsigned threads)
 {
-    // 对于变长输入，我们使用CBC-MAC的方式处理
-    // 初始向量设为0
-    uint8_t block[16] = {0};
-    size_t pos = 0;
+    if (outputs.size() != inputs.size())
+    {
+        throw std::invalid_argument("PRF并行输出数量必须与输入数量一致");
+    }
 
-    // 处理完整的16字节块
-    while (pos + 16 <= input_len)
+    // 每次领取的输入条数：足够大以摊薄调度开销，足够小以保证负载均衡
+    constexpr size_t CHUNK = 4096;
+
+    if (threads == 0)
     {
-        // 输入块与当前状态异或
-        for (int i = 0; i < 16; ++i)
-        {
-            block[i] ^= input[pos + i];
-        }
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t chunk_count = (inputs.size() + CHUNK - 1) / CHUNK;
+    threads = static_cast<unsigned>(std::min<size_t>(threads, chunk_count));
 
-        // 使用AES加密异或后的数据
-        aes_encrypt(block, block);
-        pos += 16;
+    // 数据量不足以分给多个线程时直接在当前线程计算
+    if (threads <= 1)
+    {
+        evaluate_batch(inputs, outputs);
+        return;
     }
 
-    // 处理最后一个不完整块，使用特定填充方案
-    if (pos < input_len)
+    std::atomic<size_t> next_chunk{0};
+    std::vector<std::exception_ptr> errors(threads);
+    auto worker = [&](unsigned index)
     {
-        // 输入块与当前状态异或
-        for (size_t i = 0; i < input_len - pos; ++i)
+        try
         {
-            block[i] ^= input[pos + i];
+            PRF_AES local(*this, CloneTag{});
+            for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++)
+            {
+                size_t begin = chunk * CHUNK;
+                size_t count = std::min(CHUNK, inputs.size() - begin);
+                local.evaluate_batch(inputs.subspan(begin, count), outputs.subspan(begin, count));
+            }
         }
+        catch (...)
+        {
+            // 记录异常并让其余线程不再领取新块，异常在所有线程汇合后由调用线程重新抛出
+            errors[index] = std::current_exception();
+            next_chunk = chunk_count;
+        }
+    };
 
-        // 最后一个字节设置为填充长度
-        block[input_len - pos] ^= 0x80; // 填充10000000
-        aes_encrypt(block, block);
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        try
+        {
+            pool.emplace_back(worker, t);
+        }
+        catch (const std::system_error &)
+        {
+            // 无法再创建线程时，由已启动的线程和当前线程领取剩余的块
+            break;
+        }
+    }
+    // 当前线程也参与计算
+    worker(0);
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+    for (const std::exception_ptr &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
     }
-
-    return std::string(reinterpret_cast<char *>(block), 16); // reinterpret_cast 转换为字符串
 }
@@ -4,33 +4,56 @@
 #include <string>
 #include <cstdint>
 #include <array>
+#include <span>
+#include "AES_Core.h"
 
 // 基于AES的伪随机函数实现
+// 密钥长度在运行时确定；编译期已知密钥长度时可直接使用PRF_AES_Fixed<128|192|256>
 class PRF_AES
 {
+public:
+    // AES分组加密后端(查表、位切片、AES-NI、VAES)，与OPRFTools::AESCore共用
+    using Backend = OPRFTools::AESBackend;
+
+    // PRF输出类型：16字节(128位)定长数组，无需堆分配
+    using Output = std::array<uint8_t, 16>;
+
+    // 流式计算状态：一条输入可分多段通过update送入，无需先拼接到同一缓冲区
+    struct StreamState
+    {
+        uint8_t chain[16] = {0};  // CBC-MAC链状态
+        uint8_t buffer[16] = {0}; // 尚未凑满一个分组的尾部数据
+        size_t buffered = 0;      // buffer中的有效字节数
+    };
+
 private:
     // AES密钥 (支持128位、192位或256位)
     std::string key_;
     // 密钥长度(字节)
     size_t key_len_;
 
-    // AES内部状态
-    struct AESContext
+    // AES引擎：轮密钥与后端分派，分组变换执行Nr-1轮
+    OPRFTools::AESCore engine_;
+
+    // 宽输出扩展引擎：密钥由HKDF从key_派生，与engine_相互独立
+    OPRFTools::AESCore wide_engine_;
+
+    // 计算PRF并将16字节结果写入output
+    void evaluate_into(const uint8_t *input, size_t input_len, uint8_t *output);
+
+    // 内部使用：复制轮密钥得到独立实例，供并行计算的工作线程在本核上持有
+    struct CloneTag
     {
-        uint32_t round_keys[60]; // 轮密钥
-        int rounds;              // 轮数，取决于密钥长度
     };
-    AESContext ctx_;
-
-    // 初始化AES上下文
-    void aes_init(const uint8_t *key, size_t key_len);
-    // AES加密单块数据
-    void aes_encrypt(const uint8_t *input, uint8_t *output);
+    PRF_AES(const PRF_AES &other, CloneTag);
 
 public:
-    // 构造函数，接受密钥
+    // 构造函数，接受密钥，自动选择当前CPU上最快的后端
     PRF_AES(const std::string &key);
 
+    // 构造函数，接受密钥并指定后端(后端不被当前CPU支持时抛出异常)
+    PRF_AES(const std::string &key, Backend backend);
+
     // 禁止复制构造和赋值，确保密钥安全
     PRF_AES(const PRF_AES &) = delete;
     PRF_AES &operator=(const PRF_AES &) = delete;
@@ -49,6 +72,54 @@ public:
 
     // 重载版本，接受字节数组
     std::string evaluate(const uint8_t *input, size_t input_len);
+
+    // 无分配版本：结果写入定长数组
+    void evaluate(const std::string &input, Output &output);
+    void evaluate(const uint8_t *input, size_t input_len, Output &output);
+
+    // 无分配版本：结果写入调用方提供的缓冲区的前16字节(缓冲区不足16字节时抛出异常)
+    void evaluate(const uint8_t *input, size_t input_len, std::span<uint8_t> output);
+
+    // 宽输出模式：CBC-MAC只计算一次得到标签T，再在独立的扩展密钥K_w下以计数器模式扩展到output.size()字节
+    // 第i(i >= 0)个16字节为E_{K_w}(T ^ i)，与evaluate的任何输出都不重合；长度不必是16的倍数
+    void evaluate_wide(const uint8_t *input, size_t input_len, std::span<uint8_t> output);
+    std::string evaluate_wide(const std::string &input, size_t output_len);
+
+    // 宽输出模式，输出长度在编译期确定(如32/64/128字节)
+    template <size_t N>
+    void evaluate_wide(const std::string &input, std::array<uint8_t, N> &output)
+    {
+        evaluate_wide(reinterpret_cast<const uint8_t *>(input.data()), input.size(), std::span<uint8_t>(output));
+    }
+
+    // 批量计算PRF：同时推进多条相互独立的CBC-MAC链
+    // 输出：第i个输入的16字节结果写入outputs + 16 * i，outputs至少inputs.size() * 16字节
+    void evaluate_batch(std::span<const std::string> inputs, uint8_t *outputs);
+
+    // 批量计算PRF，结果写入定长数组序列(outputs.size()必须等于inputs.size())
+    void evaluate_batch(std::span<const std::string> inputs, std::span<Output> outputs);
+
+    // 多线程并行计算PRF，outputs[i]始终对应inputs[i]
+    // threads为0时使用硬件并发线程数
+    void evaluate_parallel(std::span<const std::string> inputs, std::span<Output> outputs, unsigned threads = 0);
+
+    // 流式接口：init -> update(可多次) -> finalize，结果与一次性evaluate整条输入一致
+    void init(StreamState &stream) const;
+    void update(StreamState &stream, const uint8_t *data, size_t data_len);
+    void update(StreamState &stream, const std::string &data);
+    void finalize(StreamState &stream, Output &output);
+
+    // 获取当前使用的后端
+    Backend backend() const { return engine_.backend(); }
+
+    // 检测当前CPU上可用的最快后端
+    static Backend detect_backend();
+
+    // 判断指定后端在当前CPU上是否可用
+    static bool backend_supported(Backend backend);
+
+    // 获取后端名称，便于日志输出
+    static const char *backend_name(Backend backend);
 };
 
 #endif // PRF_AES_H
@@ -0,0 +1,348 @@
+#ifndef PRF_AES_FIXED_HPP
+#define PRF_AES_FIXED_HPP
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+
+namespace OPRFTools
+{
+    // 编译期生成的AES查找表
+    namespace AES_Tables
+    {
+        // GF(2^8)上乘以x(即乘2)，模多项式x^8 + x^4 + x^3 + x + 1
+        constexpr uint8_t xtime(uint8_t a)
+        {
+            return static_cast<uint8_t>((a << 1) ^ ((a & 0x80) ? 0x1b : 0x00));
+        }
+
+        // 8位循环左移
+        constexpr uint8_t rotl8(uint8_t x, int n)
+        {
+            return static_cast<uint8_t>((x << n) | (x >> (8 - n)));
+        }
+
+        /**
+         * @brief 编译期生成AES S盒
+         *
+         * 以3为生成元同时遍历GF(2^8)*中的p与其逆元q，对q做仿射变换得到S(p)。
+         *
+         * @return 256字节S盒
+         */
+        constexpr std::array<uint8_t, 256> make_sbox()
+        {
+            std::array<uint8_t, 256> sbox{};
+            uint8_t p = 1;
+            uint8_t q = 1;
+            do
+            {
+                // p乘以3
+                p = static_cast<uint8_t>(p ^ xtime(p));
+                // q除以3
+                q = static_cast<uint8_t>(q ^ (q << 1));
+                q = static_cast<uint8_t>(q ^ (q << 2));
+                q = static_cast<uint8_t>(q ^ (q << 4));
+                if (q & 0x80)
+                {
+                    q = static_cast<uint8_t>(q ^ 0x09);
+                }
+                // 仿射变换
+                uint8_t x = static_cast<uint8_t>(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4));
+                sbox[p] = static_cast<uint8_t>(x ^ 0x63);
+            } while (p != 1);
+            // 0没有逆元，单独处理
+            sbox[0] = 0x63;
+            return sbox;
+        }
+
+        /**
+         * @brief 编译期生成T表：将字节替换、列混合合并为一次32位查表
+         * @param rotation 循环右移位数(0、8、16、24分别对应Te0~Te3)
+         * @return 256项32位T表
+         */
+        constexpr std::array<uint32_t, 256> make_te(int rotation)
+        {
+            constexpr std::array<uint8_t, 256> sbox = make_sbox();
+            std::array<uint32_t, 256> te{};
+            for (int i = 0; i < 256; ++i)
+            {
+                uint8_t s = sbox[i];
+                uint8_t s2 = xtime(s);
+                uint8_t s3 = static_cast<uint8_t>(s2 ^ s);
+                uint32_t word = (static_cast<uint32_t>(s2) << 24) | (static_cast<uint32_t>(s) << 16) |
+                                (static_cast<uint32_t>(s) << 8) | static_cast<uint32_t>(s3);
+                te[i] = rotation == 0 ? word : ((word >> rotation) | (word << (32 - rotation)));
+            }
+            return te;
+        }
+
+        /**
+         * @brief 编译期生成AES逆S盒
+         * @return 256字节逆S盒，满足INV_SBOX[SBOX[x]] == x
+         */
+        constexpr std::array<uint8_t, 256> make_inv_sbox()
+        {
+            constexpr std::array<uint8_t, 256> sbox = make_sbox();
+            std::array<uint8_t, 256> inv{};
+            for (int i = 0; i < 256; ++i)
+            {
+                inv[sbox[i]] = static_cast<uint8_t>(i);
+            }
+            return inv;
+        }
+
+        inline constexpr std::array<uint8_t, 256> SBOX = make_sbox();
+        inline constexpr std::array<uint8_t, 256> INV_SBOX = make_inv_sbox();
+        inline constexpr std::array<uint32_t, 256> TE0 = make_te(0);
+        inline constexpr std::array<uint32_t, 256> TE1 = make_te(8);
+        inline constexpr std::array<uint32_t, 256> TE2 = make_te(16);
+        inline constexpr std::array<uint32_t, 256> TE3 = make_te(24);
+
+        static_assert(SBOX[0x00] == 0x63 && SBOX[0x53] == 0xed && SBOX[0xff] == 0x16, "AES S盒生成错误");
+        static_assert(INV_SBOX[0x63] == 0x00 && INV_SBOX[0xed] == 0x53 && INV_SBOX[0x16] == 0xff, "AES逆S盒生成错误");
+    }
+}
+
+/**
+ * @brief 编译期固定密钥长度的PRF_AES
+ *
+ * 与PRF_AES使用相同的CBC-MAC构造和分组变换，输出逐位一致。
+ * 密钥长度作为模板参数，轮数成为编译期常量，轮循环被完全展开，
+ * 不再有按轮判断是否执行列混合的分支；S盒与T表均由constexpr生成。
+ * 运行时才确定密钥长度的场景请使用PRF_AES。
+ *
+ * @tparam KeyBits 密钥长度(位)，必须为128、192或256
+ */
+template <int KeyBits>
+class PRF_AES_Fixed
+{
+    static_assert(KeyBits == 128 || KeyBits == 192 || KeyBits == 256, "AES密钥长度必须是128、192或256位");
+
+public:
+    // 密钥长度(字节)
+    static constexpr size_t KEY_BYTES = KeyBits / 8;
+    // 标准AES轮数
+    static constexpr int ROUNDS = KeyBits / 32 + 6;
+    // 分组变换实际执行的轮数：与PRF_AES查表实现一致，最后一轮(不含列混合)使用第ROUNDS-1个轮密钥
+    static constexpr int CIPHER_ROUNDS = ROUNDS - 1;
+    // 轮密钥字数
+    static constexpr size_t ROUND_KEY_WORDS = (ROUNDS + 1) * 4;
+
+    // PRF输出类型：16字节(128位)定长数组
+    using Output = std::array<uint8_t, 16>;
+
+    // 构造函数，接受密钥字符串(长度必须为KEY_BYTES)
+    explicit PRF_AES_Fixed(const std::string &key)
+    {
+        if (key.size() != KEY_BYTES)
+        {
+            throw std::invalid_argument("PRF_AES_Fixed密钥长度必须是" + std::to_string(KEY_BYTES) + "字节");
+        }
+        expand_key(reinterpret_cast<const uint8_t *>(key.data()), round_keys_.data());
+    }
+
+    // 构造函数，接受KEY_BYTES字节的密钥
+    explicit PRF_AES_Fixed(const uint8_t *key)
+    {
+        expand_key(key, round_keys_.data());
+    }
+
+    // 禁止复制构造和赋值，确保密钥安全
+    PRF_AES_Fixed(const PRF_AES_Fixed &) = delete;
+    PRF_AES_Fixed &operator=(const PRF_AES_Fixed &) = delete;
+
+    // 析构函数，清除轮密钥
+    ~PRF_AES_Fixed()
+    {
+        std::fill(round_keys_.begin(), round_keys_.end(), 0);
+    }
+
+    /**
+     * @brief 计算PRF(key, input)，结果写入定长数组
+     * @param input 指向输入数据的指针
+     * @param input_len 输入数据的长度(字节数)
+     * @param output 16字节输出数组
+     */
+    void evaluate(const uint8_t *input, size_t input_len, Output &output) const
+    {
+        // CBC-MAC，初始向量为0
+        uint8_t block[16] = {0};
+        size_t pos = 0;
+
+        // 处理完整的16字节块
+        while (pos + 16 <= input_len)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                block[i] ^= input[pos + i];
+            }
+            encrypt_block(round_keys_.data(), block, block);
+            pos += 16;
+        }
+
+        // 处理最后一个不完整块，填充10000000
+        if (pos < input_len)
+        {
+            for (size_t i = 0; i < input_len - pos; ++i)
+            {
+                block[i] ^= input[pos + i];
+            }
+            block[input_len - pos] ^= 0x80;
+            encrypt_block(round_keys_.data(), block, block);
+        }
+
+        memcpy(output.data(), block, 16);
+    }
+
+    /**
+     * @brief 计算PRF(key, input)
+     * @param input 输入的字符串数据
+     * @return 16字节PRF输出
+     */
+    Output evaluate(const std::string &input) const
+    {
+        Output output;
+        evaluate(reinterpret_cast<const uint8_t *>(input.data()), input.size(), output);
+        return output;
+    }
+
+    /**
+     * @brief AES密钥扩展，生成大端字形式的轮密钥
+     * @param key KEY_BYTES字节的原始密钥
+     * @param round_keys 输出，ROUND_KEY_WORDS个32位字
+     */
+    static void expand_key(const uint8_t *key, uint32_t *round_keys)
+    {
+        constexpr int nk = KeyBits / 32;
+        constexpr uint8_t RCON[11] = {0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+        const auto &sbox = OPRFTools::AES_Tables::SBOX;
+
+        for (int i = 0; i < nk; ++i)
+        {
+            round_keys[i] = load_be32(key + 4 * i);
+        }
+        for (int i = nk; i < static_cast<int>(ROUND_KEY_WORDS); ++i)
+        {
+            uint32_t temp = round_keys[i - 1];
+            if (i % nk == 0)
+            {
+                // RotWord、SubWord与Rcon异或
+                temp = (temp << 8) | (temp >> 24);
+                temp = sub_word(temp, sbox) ^ (static_cast<uint32_t>(RCON[i / nk]) << 24);
+            }
+            else if (nk > 6 && i % nk == 4)
+            {
+                // 256位密钥额外处理
+                temp = sub_word(temp, sbox);
+            }
+            round_keys[i] = round_keys[i - nk] ^ temp;
+        }
+    }
+
+    /**
+     * @brief 使用T表加密单个分组，CIPHER_ROUNDS轮在编译期完全展开
+     * @param round_keys 大端字形式的轮密钥
+     * @param input 16字节输入
+     * @param output 16字节输出，可与input相同
+     */
+    static void encrypt_block(const uint32_t *round_keys, const uint8_t *input, uint8_t *output)
+    {
+        encrypt_rounds<CIPHER_ROUNDS>(round_keys, input, output);
+    }
+
+    /**
+     * @brief 使用T表执行指定轮数的AES加密，Rounds == ROUNDS时即为标准AES
+     * @tparam Rounds 轮数，最后一轮不含列混合并使用第Rounds个轮密钥
+     * @param round_keys 大端字形式的轮密钥
+     * @param input 16字节输入
+     * @param output 16字节输出，可与input相同
+     */
+    template <int Rounds>
+    static void encrypt_rounds(const uint32_t *round_keys, const uint8_t *input, uint8_t *output)
+    {
+        static_assert(Rounds >= 1 && Rounds <= ROUNDS, "轮数超出轮密钥范围");
+
+        uint32_t s[4] = {
+            load_be32(input) ^ round_keys[0],
+            load_be32(input + 4) ^ round_keys[1],
+            load_be32(input + 8) ^ round_keys[2],
+            load_be32(input + 12) ^ round_keys[3]};
+
+        // 第1~Rounds-1轮：字节替换 + 行移位 + 列混合 + 轮密钥加
+        [&]<int... R>(std::integer_sequence<int, R...>)
+        {
+            (full_round<R + 1>(s, round_keys), ...);
+        }(std::make_integer_sequence<int, Rounds - 1>{});
+
+        // 最后一轮：字节替换 + 行移位 + 轮密钥加
+        const auto &sbox = OPRFTools::AES_Tables::SBOX;
+        const uint32_t *rk = round_keys + 4 * Rounds;
+        for (int c = 0; c < 4; ++c)
+        {
+            uint32_t word = (static_cast<uint32_t>(sbox[s[c] >> 24]) << 24) |
+                            (static_cast<uint32_t>(sbox[(s[(c + 1) & 3] >> 16) & 0xff]) << 16) |
+                            (static_cast<uint32_t>(sbox[(s[(c + 2) & 3] >> 8) & 0xff]) << 8) |
+                            static_cast<uint32_t>(sbox[s[(c + 3) & 3] & 0xff]);
+            store_be32(output + 4 * c, word ^ rk[c]);
+        }
+    }
+
+private:
+    // 大端字形式的轮密钥
+    std::array<uint32_t, ROUND_KEY_WORDS> round_keys_{};
+
+    // 大端序读取32位字
+    static uint32_t load_be32(const uint8_t *p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    // 大端序写入32位字
+    static void store_be32(uint8_t *p, uint32_t x)
+    {
+        p[0] = static_cast<uint8_t>(x >> 24);
+        p[1] = static_cast<uint8_t>(x >> 16);
+        p[2] = static_cast<uint8_t>(x >> 8);
+        p[3] = static_cast<uint8_t>(x);
+    }
+
+    // 对32位字的4个字节分别做S盒替换
+    static uint32_t sub_word(uint32_t x, const std::array<uint8_t, 256> &sbox)
+    {
+        return (static_cast<uint32_t>(sbox[x >> 24]) << 24) | (static_cast<uint32_t>(sbox[(x >> 16) & 0xff]) << 16) |
+               (static_cast<uint32_t>(sbox[(x >> 8) & 0xff]) << 8) | static_cast<uint32_t>(sbox[x & 0xff]);
+    }
+
+    /**
+     * @brief 完整的一轮T表变换，轮密钥偏移为编译期常量
+     * @tparam Round 轮序号
+     * @param s 4个大端字表示的状态
+     * @param round_keys 轮密钥
+     */
+    template <int Round>
+    static inline void full_round(uint32_t *s, const uint32_t *round_keys)
+    {
+        using namespace OPRFTools::AES_Tables;
+        const uint32_t *rk = round_keys + 4 * Round;
+        uint32_t t0 = TE0[s[0] >> 24] ^ TE1[(s[1] >> 16) & 0xff] ^ TE2[(s[2] >> 8) & 0xff] ^ TE3[s[3] & 0xff] ^ rk[0];
+        uint32_t t1 = TE0[s[1] >> 24] ^ TE1[(s[2] >> 16) & 0xff] ^ TE2[(s[3] >> 8) & 0xff] ^ TE3[s[0] & 0xff] ^ rk[1];
+        uint32_t t2 = TE0[s[2] >> 24] ^ TE1[(s[3] >> 16) & 0xff] ^ TE2[(s[0] >> 8) & 0xff] ^ TE3[s[1] & 0xff] ^ rk[2];
+        uint32_t t3 = TE0[s[3] >> 24] ^ TE1[(s[0] >> 16) & 0xff] ^ TE2[(s[1] >> 8) & 0xff] ^ TE3[s[2] & 0xff] ^ rk[3];
+        s[0] = t0;
+        s[1] = t1;
+        s[2] = t2;
+        s[3] = t3;
+    }
+};
+
+// 常用密钥长度的别名
+using PRF_AES128 = PRF_AES_Fixed<128>;
+using PRF_AES192 = PRF_AES_Fixed<192>;
+using PRF_AES256 = PRF_AES_Fixed<256>;
+
+#endif // PRF_AES_FIXED_HPP
@@ -9,6 +9,8 @@
 #include "test_demo/HashDemo.h"
 #include "test_demo/PRFDemo.h"
 #include "test_demo/PRPDemo.h"
+#include "test_demo/BenchDemo.h"
+#include "test_demo/BFDemo.h"
 
 // 包含SocketTools头文件
 #include "SocketTools/Server_Receiver.hpp"
@@ -18,7 +20,6 @@
 #include "OPRFTools/DH/DH_Sender.hpp"
 #include "OPRFTools/DH/DH_Receiver.hpp"
 
-#include "CryptoTools/BF.hpp"
 
 using namespace std;
 // 实现辅助函数
@@ -91,22 +92,15 @@ int main(int argc, char const *argv[])
         return PRPDemo();
         // return 1;
     }
+    else if (argc > 1 && string(argv[1]) == "--bench")
+    {
+        // 测量AES各实现层级的批量吞吐量
+        return AESBenchDemo();
+    }
     else if (argc > 1 && string(argv[1]) == "--BF")
     {
-        // 创建布隆过滤器：预期1000个元素，误判率0.01, hash 函数数量为3
-        CryptoTools::BloomFilter<std::string> filter(1000, 0.01, 3);
-
-        // 插入元素
-        filter.insert("apple");
-        filter.insert("banana");
-        filter.insert("cherry");
-
-        // 检查元素
-        std::cout << "apple: " << (filter.contains("apple") ? "可能存在" : "不存在") << std::endl;
-        std::cout << "banana: " << (filter.contains("banana") ? "可能存在" : "不存在") << std::endl;
-        std::cout << "orange: " << (filter.contains("orange") ? "可能存在" : "不存在") << std::endl;
-
-        return 0;
+        // 标准/分块布隆过滤器演示与误判率对比
+        return BFDemo();
     }
     else if (argc > 1 && string(argv[1]) == "--oprf")
     {
@@ -118,7 +112,7 @@ int main(int argc, char const *argv[])
             // 运行接收方
             OPRFTools::DH_Receiver dh_receiver;
             std::vector<std::string> datasets = {"1", "2", "3"};                   // 可以传入数据集参数
-            std::vector<std::string> receiver_outputs = dh_receiver.run(datasets); // 运行发送方
+            std::vector<PRF_AES::Output> receiver_outputs = dh_receiver.run(datasets); // 运行发送方
             // for (const auto &output : receiver_outputs)
             // {
             //     std::cout << output << std::endl;
@@ -131,7 +125,7 @@ int main(int argc, char const *argv[])
             // 运行发送方
             OPRFTools::DH_Sender dh_sender;
             std::vector<std::string> datasets = {"1", "2", "4"}; // 可以传入数据集参数
-            std::vector<std::string> sender_outputs = dh_sender.run(datasets);
+            std::vector<PRF_AES::Output> sender_outputs = dh_sender.run(datasets);
             // for (const auto &output : sender_outputs)
             // {
             //     std::cout << output << std::endl;
@@ -154,7 +148,8 @@ int main(int argc, char const *argv[])
         cout << "  --hash         Run the hash demo" << endl;
         cout << "  --prf          Run the PRF demo" << endl;
         cout << "  --prp          Run the PRP demo" << endl;
-        cout << "  --BF          Run the PRP demo" << endl
+        cout << "  --bench        Run the AES throughput benchmarks" << endl;
+        cout << "  --BF           Run the Bloom filter demo" << endl
              << endl;
         cout << "   Two terminals need to be opened: " << endl;
         cout << "  --socket [0|1] Run the socket demo (0 for Server, 1 for Client)" << endl;
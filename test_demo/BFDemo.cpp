@@ -0,0 +1,208 @@
+#include "BFDemo.h"
+#include "../OPRFTools/PRF_AES.h"
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+int BFDemo()
+{
+    try
+    {
+        // 创建布隆过滤器：预期1000个元素，误判率0.01, hash 函数数量为3
+        CryptoTools::BloomFilter<std::string> filter(1000, 0.01, 3);
+
+        // 插入元素
+        filter.insert("apple");
+        filter.insert("banana");
+        filter.insert("cherry");
+
+        // 检查元素
+        std::cout << "apple: " << (filter.contains("apple") ? "可能存在" : "不存在") << std::endl;
+        std::cout << "banana: " << (filter.contains("banana") ? "可能存在" : "不存在") << std::endl;
+        std::cout << "orange: " << (filter.contains("orange") ? "可能存在" : "不存在") << std::endl;
+
+        // 标准布隆过滤器存放OPRF输出：包装为UniformKey128后，16字节伪随机键直接作为双重哈希的h1/h2，不再计算哈希
+        const size_t oprf_items = 100000;
+        const size_t oprf_queries = 4 * oprf_items;
+        std::vector<std::string> oprf_inputs(oprf_items + oprf_queries);
+        for (size_t i = 0; i < oprf_inputs.size(); ++i)
+        {
+            oprf_inputs[i] = "user-" + std::to_string(i);
+        }
+        std::vector<PRF_AES::Output> prf_outputs(oprf_inputs.size());
+        PRF_AES(std::string(32, 'k')).evaluate_batch(oprf_inputs, prf_outputs);
+        std::vector<CryptoTools::UniformKey128> oprf_outputs(prf_outputs.size());
+        for (size_t i = 0; i < prf_outputs.size(); ++i)
+        {
+            oprf_outputs[i].bytes = prf_outputs[i];
+        }
+
+        CryptoTools::BloomFilter<CryptoTools::UniformKey128> oprf_filter(oprf_items, 0.01, 7);
+        CryptoTools::BloomFilter<std::string> string_filter(oprf_items, 0.01, 7);
+        for (size_t i = 0; i < oprf_items; ++i)
+        {
+            oprf_filter.insert(oprf_outputs[i]);
+            string_filter.insert(oprf_inputs[i]);
+        }
+
+        size_t oprf_false_positives = 0;
+        size_t string_false_positives = 0;
+        auto oprf_start = std::chrono::high_resolution_clock::now();
+        for (size_t i = oprf_items; i < oprf_outputs.size(); ++i)
+        {
+            oprf_false_positives += oprf_filter.contains(oprf_outputs[i]) ? 1 : 0;
+        }
+        auto string_start = std::chrono::high_resolution_clock::now();
+        for (size_t i = oprf_items; i < oprf_inputs.size(); ++i)
+        {
+            string_false_positives += string_filter.contains(oprf_inputs[i]) ? 1 : 0;
+        }
+        auto string_end = std::chrono::high_resolution_clock::now();
+        double oprf_seconds = std::chrono::duration<double>(string_start - oprf_start).count();
+        double string_seconds = std::chrono::duration<double>(string_end - string_start).count();
+
+        double oprf_theory = CryptoTools::BloomFilterCalculator::standard_false_positive_rate(oprf_items, oprf_filter.get_bit_size(), oprf_filter.get_hash_count());
+        double oprf_rate = static_cast<double>(oprf_false_positives) / static_cast<double>(oprf_queries);
+        double string_rate = static_cast<double>(string_false_positives) / static_cast<double>(oprf_queries);
+        std::cout << "\n=== 标准布隆过滤器 (n = " << oprf_items << ", k = " << oprf_filter.get_hash_count() << ") ===" << std::endl;
+        std::cout << "  理论误判率: " << oprf_theory << std::endl;
+        std::cout << "  OPRF输出键: 实测误判率 " << oprf_rate << ", 查询吞吐量 "
+                  << std::fixed << std::setprecision(1) << oprf_queries / oprf_seconds / 1e6 << " M次/秒" << std::defaultfloat << std::endl;
+        std::cout << "  字符串键:   实测误判率 " << string_rate << ", 查询吞吐量 "
+                  << std::fixed << std::setprecision(1) << oprf_queries / string_seconds / 1e6 << " M次/秒" << std::defaultfloat << std::endl;
+        for (size_t i = 0; i < oprf_items; ++i)
+        {
+            if (!oprf_filter.contains(oprf_outputs[i]) || !string_filter.contains(oprf_inputs[i]))
+            {
+                std::cout << "❌ 标准布隆过滤器出现漏报" << std::endl;
+                return 1;
+            }
+        }
+        if (oprf_rate > 1.5 * oprf_theory || string_rate > 1.5 * oprf_theory)
+        {
+            std::cout << "❌ 标准布隆过滤器实测误判率明显高于理论值" << std::endl;
+            return 1;
+        }
+
+        // 批量接口：位数组远大于缓存时，窗口内先预取全部探测位置再测试，缓存未命中相互重叠
+        const size_t batch_items = 8000000;
+        std::vector<uint64_t> batch_keys(batch_items);
+        for (size_t i = 0; i < batch_items; ++i)
+        {
+            batch_keys[i] = i * 0x9E3779B97F4A7C15ULL;
+        }
+        CryptoTools::BloomFilter<uint64_t> batch_filter(batch_items, 0.01, 7);
+        auto build_start = std::chrono::high_resolution_clock::now();
+        batch_filter.insert_batch(batch_keys);
+        auto build_end = std::chrono::high_resolution_clock::now();
+
+        // 并发模式：多个线程用fetch_or同时置位，构建出的位数组与单线程完全相同
+        const unsigned build_threads = std::max(4u, std::thread::hardware_concurrency());
+        CryptoTools::ConcurrentBloomFilter<uint64_t> concurrent_filter(batch_items, 0.01, 7);
+        concurrent_filter.insert_parallel(batch_keys, build_threads);
+        auto parallel_end = std::chrono::high_resolution_clock::now();
+
+        // 查询一半成员、一半非成员
+        const size_t batch_queries = batch_items / 2;
+        std::vector<uint64_t> query_keys(batch_queries);
+        for (size_t i = 0; i < batch_queries; ++i)
+        {
+            query_keys[i] = (i % 2 == 0) ? batch_keys[(i * 7919) % batch_items] : i * 0x9E3779B97F4A7C15ULL + 1;
+        }
+
+        std::vector<uint64_t> single_bitmap((batch_queries + 63) / 64, 0);
+        auto single_start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < batch_queries; ++i)
+        {
+            single_bitmap[i >> 6] |= uint64_t(batch_filter.contains(query_keys[i])) << (i & 63);
+        }
+        auto batch_start = std::chrono::high_resolution_clock::now();
+        std::vector<uint64_t> batch_bitmap = batch_filter.contains_batch(query_keys);
+        auto batch_end = std::chrono::high_resolution_clock::now();
+        double single_seconds = std::chrono::duration<double>(batch_start - single_start).count();
+        double batch_seconds = std::chrono::duration<double>(batch_end - batch_start).count();
+
+        std::cout << "\n=== 标准布隆过滤器批量查询 (n = " << batch_items << ", "
+                  << batch_filter.get_bit_size() / 8 / 1024 << " KiB) ===" << std::endl;
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  insert_batch构建:              " << batch_items / std::chrono::duration<double>(build_end - build_start).count() / 1e6 << " M次/秒" << std::endl
+                  << "  insert_parallel构建(" << build_threads << "线程): "
+                  << batch_items / std::chrono::duration<double>(parallel_end - build_end).count() / 1e6 << " M次/秒" << std::endl
+                  << "  逐个contains:  " << batch_queries / single_seconds / 1e6 << " M次/秒" << std::endl
+                  << "  contains_batch: " << batch_queries / batch_seconds / 1e6 << " M次/秒" << std::endl
+                  << std::defaultfloat;
+        bool members_found = true;
+        for (size_t i = 0; i < batch_queries; i += 2)
+        {
+            members_found &= (batch_bitmap[i >> 6] >> (i & 63)) & 1;
+        }
+        if (batch_bitmap != single_bitmap || !members_found ||
+            concurrent_filter.contains_batch(query_keys) != batch_bitmap ||
+            concurrent_filter.get_item_count() != batch_filter.get_item_count())
+        {
+            std::cout << "❌ 批量查询或并行构建的结果与逐个查询不一致，或出现漏报" << std::endl;
+            return 1;
+        }
+
+        // 空间与误判率：分块布局需要稍多的空间才能达到相同的误判率
+        const size_t items = 1000000;
+        std::cout << "\n=== 误判率与空间 (n = " << items << ") ===" << std::endl;
+        std::cout << "  位/元素    标准(最佳k)         分块512位(最佳k)" << std::endl;
+        for (size_t bits_per_item : {8, 10, 12, 16, 20, 24})
+        {
+            size_t bits = items * bits_per_item;
+            size_t standard_k = std::max<size_t>(1, static_cast<size_t>(std::round(bits_per_item * std::log(2))));
+            size_t blocked_k = CryptoTools::BloomFilterCalculator::optimal_blocked_hash_count(items, bits);
+            std::cout << "  " << std::setw(6) << bits_per_item
+                      << "    " << std::scientific << std::setprecision(3)
+                      << CryptoTools::BloomFilterCalculator::standard_false_positive_rate(items, bits, standard_k)
+                      << " (k=" << std::setw(2) << standard_k << ")    "
+                      << CryptoTools::BloomFilterCalculator::blocked_false_positive_rate(items, bits, blocked_k)
+                      << " (k=" << std::setw(2) << blocked_k << ")" << std::defaultfloat << std::endl;
+        }
+
+        // 分块布隆过滤器：按分块公式确定大小，实测误判率
+        const double target_rate = 0.01;
+        CryptoTools::BlockedBloomFilter<uint64_t> blocked(items, target_rate);
+        for (uint64_t i = 0; i < items; ++i)
+        {
+            blocked.insert(i);
+        }
+
+        size_t false_negatives = 0;
+        for (uint64_t i = 0; i < items; ++i)
+        {
+            false_negatives += blocked.contains(i) ? 0 : 1;
+        }
+
+        const size_t queries = 4 * items;
+        size_t false_positives = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint64_t i = 0; i < queries; ++i)
+        {
+            false_positives += blocked.contains(i + (uint64_t(1) << 40)) ? 1 : 0;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        double measured_rate = static_cast<double>(false_positives) / static_cast<double>(queries);
+
+        std::cout << "\n=== 分块布隆过滤器 (目标误判率 " << target_rate << ") ===" << std::endl;
+        std::cout << "  大小: " << blocked.get_bit_size() / 8 / 1024 << " KiB ("
+                  << static_cast<double>(blocked.get_bit_size()) / items << " 位/元素), k = " << blocked.get_hash_count() << std::endl;
+        std::cout << "  理论误判率: " << blocked.estimated_false_positive_rate() << ", 实测误判率: " << measured_rate << std::endl;
+        std::cout << "  查询吞吐量: " << std::fixed << std::setprecision(1) << queries / seconds / 1e6 << " M次/秒" << std::defaultfloat << std::endl;
+
+        // 实测值允许一定的统计波动
+        if (false_negatives != 0 || measured_rate > 1.5 * target_rate)
+        {
+            std::cout << "❌ 分块布隆过滤器结果异常：漏报 " << false_negatives << " 个" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ 无漏报，实测误判率符合预期" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "错误：" << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+#ifndef BF_DEMO_H
+#define BF_DEMO_H
+
+#include "../CryptoTools/BF.hpp"
+#include <iostream>
+#include <string>
+
+/**
+ * @brief 布隆过滤器演示函数
+ *
+ * 演示标准布隆过滤器与分块布隆过滤器的插入与查询，实测标准布隆过滤器存放OPRF输出与字符串时的误判率与吞吐量、批量查询相对逐个查询的吞吐量、并发模式多线程构建的结果，
+ * 打印两种布局在不同空间下的理论误判率，并实测分块布隆过滤器的误判率与查询吞吐量。
+ *
+ * @return 0：两种布隆过滤器均无漏报且实测误判率与理论值相符；1：存在异常
+ */
+int BFDemo();
+
+#endif // BF_DEMO_H
@@ -0,0 +1,293 @@
+#include "BenchDemo.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+// 每项测量至少持续的时间(秒)，避免计时器精度影响结果
+static constexpr double MIN_BENCH_SECONDS = 0.2;
+
+/**
+ * @brief 重复执行func直到累计时间不少于MIN_BENCH_SECONDS，返回吞吐量
+ * @param bytes_per_run 每次执行处理的字节数
+ * @param func 待测函数
+ * @return 吞吐量(MB/s)
+ */
+template <typename Func>
+static double measure_throughput(size_t bytes_per_run, Func &&func)
+{
+    using clock = std::chrono::steady_clock;
+    func(); // 预热：触发缓存与分支预测
+
+    size_t runs = 0;
+    auto start = clock::now();
+    double elapsed = 0;
+    do
+    {
+        func();
+        ++runs;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < MIN_BENCH_SECONDS);
+
+    return static_cast<double>(bytes_per_run) * runs / elapsed / 1e6;
+}
+
+/**
+ * @brief 打印一行测量结果
+ * @param tier 实现层级名称
+ * @param mbps 吞吐量(MB/s)
+ * @param consistent 输出是否与参考实现一致
+ */
+static void print_result(const char *tier, double mbps, bool consistent)
+{
+    std::cout << "  " << std::left << std::setw(10) << tier << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << mbps << " MB/s  " << (consistent ? "✅" : "❌") << std::endl;
+}
+
+int AESBenchDemo()
+{
+    try
+    {
+        bool all_consistent = true;
+
+        // PRF_AES：OPRF场景下的批量短输入(单分组)与多分组输入
+        const std::string key = "0123456789abcdef";
+        const PRF_AES::Backend prf_tiers[] = {PRF_AES::Backend::Table, PRF_AES::Backend::Bitslice,
+                                              PRF_AES::Backend::AESNI, PRF_AES::Backend::VAES};
+        for (size_t input_len : {16, 64})
+        {
+            const size_t count = 1 << 14;
+            std::vector<std::string> inputs(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                inputs[i] = std::string(input_len, static_cast<char>(i));
+                memcpy(inputs[i].data(), &i, sizeof(i));
+            }
+
+            std::cout << "PRF_AES::evaluate_batch (" << count << " x " << input_len << " 字节)" << std::endl;
+            std::vector<PRF_AES::Output> reference(count);
+            PRF_AES(key, PRF_AES::Backend::Table).evaluate_batch(inputs, reference);
+            for (PRF_AES::Backend tier : prf_tiers)
+            {
+                if (!PRF_AES::backend_supported(tier))
+                {
+                    continue;
+                }
+                PRF_AES prf(key, tier);
+                std::vector<PRF_AES::Output> outputs(count);
+                double mbps = measure_throughput(count * input_len, [&]
+                                                 { prf.evaluate_batch(inputs, outputs); });
+                bool consistent = outputs == reference;
+                all_consistent = all_consistent && consistent;
+                print_result(PRF_AES::backend_name(tier), mbps, consistent);
+            }
+        }
+
+        // PRP_AES：对连续分组做批量置换
+        {
+            const size_t block_count = 1 << 16;
+            std::vector<unsigned char> input(block_count * 16);
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                input[i] = static_cast<unsigned char>(i * 131 + 7);
+            }
+            std::vector<unsigned char> prp_key = CryptoTools::PRP_AES::generate_random_key(128);
+
+            // 统一AES引擎的各后端直接与EVP路径对比
+            const CryptoTools::PRP_AES::Backend tiers[] = {CryptoTools::PRP_AES::Backend::EVP, CryptoTools::PRP_AES::Backend::Table,
+                                                           CryptoTools::PRP_AES::Backend::Bitslice, CryptoTools::PRP_AES::Backend::AESNI,
+                                                           CryptoTools::PRP_AES::Backend::VAES};
+
+            std::cout << "PRP_AES::permute_blocks (" << block_count << " 个分组)" << std::endl;
+            std::vector<unsigned char> reference(input.size());
+            CryptoTools::PRP_AES(prp_key.data(), 128, CryptoTools::PRP_AES::Backend::EVP).permute_blocks(input.data(), reference.data(), block_count);
+            for (auto tier : tiers)
+            {
+                if (!CryptoTools::PRP_AES::backend_supported(tier))
+                {
+                    continue;
+                }
+                CryptoTools::PRP_AES prp(prp_key.data(), 128, tier);
+                std::vector<unsigned char> output(input.size());
+                double mbps = measure_throughput(input.size(), [&]
+                                                 { prp.permute_blocks(input.data(), output.data(), block_count); });
+                bool consistent = output == reference;
+                all_consistent = all_consistent && consistent;
+                print_result(CryptoTools::PRP_AES::backend_name(tier), mbps, consistent);
+            }
+
+            std::cout << "PRP_AES::inverse_permute_blocks (" << block_count << " 个分组)" << std::endl;
+            for (auto tier : tiers)
+            {
+                if (!CryptoTools::PRP_AES::backend_supported(tier))
+                {
+                    continue;
+                }
+                CryptoTools::PRP_AES prp(prp_key.data(), 128, tier);
+                std::vector<unsigned char> output(input.size());
+                double mbps = measure_throughput(input.size(), [&]
+                                                 { prp.inverse_permute_blocks(reference.data(), output.data(), block_count); });
+                bool consistent = output == input;
+                all_consistent = all_consistent && consistent;
+                print_result(CryptoTools::PRP_AES::backend_name(tier), mbps, consistent);
+            }
+
+            std::cout << "PRP_AES 多线程 / CTR / 逐块对照 (" << block_count << " 个分组)" << std::endl;
+            // 多线程共享同一实例：EVP路径各线程从上下文池租用独立上下文
+            for (auto tier : {CryptoTools::PRP_AES::Backend::EVP, CryptoTools::PRP_AES::detect_backend()})
+            {
+                CryptoTools::PRP_AES prp(prp_key.data(), 128, tier);
+                std::vector<unsigned char> output(input.size());
+                double mbps = measure_throughput(input.size(), [&]
+                                                 { prp.permute_blocks_parallel(input.data(), output.data(), block_count); });
+                bool consistent = output == reference;
+                all_consistent = all_consistent && consistent;
+                print_result((std::string(CryptoTools::PRP_AES::backend_name(tier)) + "-mt").c_str(), mbps, consistent);
+            }
+
+            // CTR模式：对同一段数据原地加/解密(数据长度与上面的批量置换相同)
+            {
+                CryptoTools::PRP_AES prp(prp_key.data(), 128);
+                unsigned char iv[16] = {0};
+                std::vector<unsigned char> data(input);
+                double mbps = measure_throughput(data.size(), [&]
+                                                 { prp.ctr_xor(iv, data.data(), data.size()); });
+                double mt_mbps = measure_throughput(data.size(), [&]
+                                                    { prp.ctr_xor_parallel(iv, data.data(), data.size()); });
+                // 测量期间执行了偶数或奇数次异或，再整体异或一次比较两种结果之一
+                bool consistent = data == input;
+                if (!consistent)
+                {
+                    prp.ctr_xor(iv, data.data(), data.size());
+                    consistent = data == input;
+                }
+                all_consistent = all_consistent && consistent;
+                print_result("ctr", mbps, consistent);
+                print_result("ctr-mt", mt_mbps, consistent);
+            }
+
+            // 逐块调用permute作为对照，体现批量接口的收益
+            CryptoTools::PRP_AES prp(prp_key.data(), 128);
+            std::vector<unsigned char> output(input.size());
+            double mbps = measure_throughput(input.size(), [&]
+                                             {
+                for (size_t i = 0; i < block_count; ++i)
+                {
+                    prp.permute(input.data() + 16 * i, output.data() + 16 * i);
+                } });
+            bool consistent = output == reference;
+            all_consistent = all_consistent && consistent;
+            print_result("per-block", mbps, consistent);
+        }
+
+        // FixedKeyAESHash：MMO结构的批量哈希
+        {
+            const size_t count = 1 << 16;
+            std::vector<FixedKeyAESHash::Block> input(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                memcpy(input[i].data(), &i, sizeof(i));
+            }
+
+            std::cout << "FixedKeyAESHash::hash_batch (" << count << " 个分组)" << std::endl;
+            static const uint8_t hash_key[16] = {0x24, 0x3f, 0x6a, 0x88, 0x85, 0xa3, 0x08, 0xd3,
+                                                 0x13, 0x19, 0x8a, 0x2e, 0x03, 0x70, 0x73, 0x44};
+            std::vector<FixedKeyAESHash::Block> reference(count);
+            FixedKeyAESHash(hash_key, PRF_AES::Backend::Table).hash_batch(input, reference);
+            for (PRF_AES::Backend tier : prf_tiers)
+            {
+                if (!PRF_AES::backend_supported(tier))
+                {
+                    continue;
+                }
+                FixedKeyAESHash hash(hash_key, tier);
+                std::vector<FixedKeyAESHash::Block> output(count);
+                double mbps = measure_throughput(count * 16, [&]
+                                                 { hash.hash_batch(input, output); });
+                bool consistent = output == reference;
+                all_consistent = all_consistent && consistent;
+                print_result(PRF_AES::backend_name(tier), mbps, consistent);
+            }
+        }
+
+        // SHA256::hash_many：大量短消息的多缓冲区哈希
+        {
+            const size_t count = 1 << 16;
+            const size_t message_len = 32;
+            std::vector<std::string> storage(count, std::string(message_len, 'x'));
+            for (size_t i = 0; i < count; ++i)
+            {
+                memcpy(storage[i].data(), &i, sizeof(i));
+            }
+            std::vector<std::string_view> messages(storage.begin(), storage.end());
+
+            std::cout << "SHA256::hash_many (" << count << " x " << message_len << " 字节)" << std::endl;
+            std::vector<std::array<uint8_t, 32>> reference(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                SHA256 sha256(SHA256::Backend::Scalar);
+                sha256.input(storage[i]);
+                reference[i] = sha256.digest();
+            }
+            for (auto tier : {SHA256::BatchBackend::Serial, SHA256::BatchBackend::AVX2, SHA256::BatchBackend::AVX512})
+            {
+                if (!SHA256::batch_backend_supported(tier))
+                {
+                    continue;
+                }
+                std::vector<std::array<uint8_t, 32>> output;
+                double mbps = measure_throughput(count * message_len, [&]
+                                                 { output = SHA256::hash_many(messages, tier); });
+                bool consistent = output == reference;
+                all_consistent = all_consistent && consistent;
+                print_result(SHA256::batch_backend_name(tier), mbps, consistent);
+            }
+        }
+
+        // HexCodec：十六进制编码/解码
+        {
+            const size_t length = 1 << 20;
+            std::vector<uint8_t> bytes(length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                bytes[i] = static_cast<uint8_t>(i * 131 + 7);
+            }
+            std::string reference(2 * length, '\0');
+            CryptoTools::HexCodec::encode(bytes.data(), length, reference.data(), CryptoTools::HexCodec::Backend::Scalar);
+
+            std::cout << "HexCodec::encode / decode (" << length << " 字节)" << std::endl;
+            for (auto tier : {CryptoTools::HexCodec::Backend::Scalar, CryptoTools::HexCodec::Backend::SSSE3, CryptoTools::HexCodec::Backend::AVX2})
+            {
+                if (!CryptoTools::HexCodec::backend_supported(tier))
+                {
+                    continue;
+                }
+                std::string hex(2 * length, '\0');
+                std::vector<uint8_t> decoded(length);
+                bool decode_ok = true;
+                double encode_mbps = measure_throughput(length, [&]
+                                                        { CryptoTools::HexCodec::encode(bytes.data(), length, hex.data(), tier); });
+                double decode_mbps = measure_throughput(length, [&]
+                                                        { decode_ok = CryptoTools::HexCodec::decode(hex.data(), hex.size(), decoded.data(), tier) && decode_ok; });
+                bool consistent = hex == reference && decode_ok && decoded == bytes;
+                all_consistent = all_consistent && consistent;
+                print_result((std::string(CryptoTools::HexCodec::backend_name(tier)) + "-enc").c_str(), encode_mbps, consistent);
+                print_result((std::string(CryptoTools::HexCodec::backend_name(tier)) + "-dec").c_str(), decode_mbps, consistent);
+            }
+        }
+
+        if (!all_consistent)
+        {
+            std::cout << "错误：存在与参考实现不一致的层级 ❌" << std::endl;
+            return 1;
+        }
+        std::cout << "验证：所有层级输出与参考实现一致 ✅" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "错误：" << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
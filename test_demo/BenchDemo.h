@@ -0,0 +1,23 @@
+#ifndef BENCH_DEMO_H
+#define BENCH_DEMO_H
+
+#include "../OPRFTools/PRF_AES.h"
+#include "../OPRFTools/FixedKeyAESHash.h"
+#include "../CryptoTools/PRP_AES.hpp"
+#include "../HashTools/SHA_Family/SHA256.hpp"
+#include "../CryptoTools/HexCodec.hpp"
+#include <iostream>
+#include <string>
+
+/**
+ * @brief AES各实现层级(查表/位切片、AES-NI、VAES)的批量吞吐量基准测试
+ *
+ * 分别测量PRF_AES::evaluate_batch、PRP_AES::permute_blocks与FixedKeyAESHash::hash_batch，
+ * 以及SHA256::hash_many的各多缓冲区后端与HexCodec的各编解码后端；
+ * 当前CPU不支持的层级会被跳过；每个层级的输出都与参考实现比对。
+ *
+ * @return 0：全部层级输出一致；1：存在不一致或出现异常
+ */
+int AESBenchDemo();
+
+#endif // BENCH_DEMO_H
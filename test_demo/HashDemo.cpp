@@ -1,5 +1,8 @@
 #include "HashDemo.h"
 #include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
 
 // 字符串转哈希值（整数）
 /**
@@ -107,11 +110,162 @@ void SHA256Demo()
     // 输出SHA256哈希结果
     std::cout << "SHA256 hash of \"Hello, World!\": " << sha256.output() << std::endl; 
 }
+/**
+ * @brief SHA256已知答案测试，覆盖当前CPU支持的每个压缩函数后端
+ *
+ * 使用FIPS 180-2附录中的测试向量（含100万个'a'的长消息），
+ * 并比较各后端对0~200字节输入（一次性输入与分段update()）的结果与标量实现是否一致。
+ *
+ * @return 全部通过返回true
+ */
+bool SHA256KnownAnswerTest()
+{
+    struct Vector
+    {
+        std::string message;
+        const char *digest;
+    };
+    const Vector vectors[] = {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"}};
+
+    bool all_passed = true;
+    for (auto backend : {SHA256::Backend::Scalar, SHA256::Backend::SHANI, SHA256::Backend::ARMv8})
+    {
+        if (!SHA256::backend_supported(backend))
+        {
+            std::cout << "  " << SHA256::backend_name(backend) << ": 当前CPU不支持，跳过\n";
+            continue;
+        }
+
+        bool passed = true;
+        for (const auto &vector : vectors)
+        {
+            SHA256 sha256(backend);
+            sha256.input(vector.message);
+            passed = passed && sha256.output() == vector.digest;
+        }
+
+        // 覆盖填充跨块的各种长度
+        for (size_t length = 0; length <= 200; ++length)
+        {
+            std::string message(length, '\0');
+            for (size_t i = 0; i < length; ++i)
+            {
+                message[i] = static_cast<char>(i * 31 + length);
+            }
+            SHA256 reference(SHA256::Backend::Scalar), sha256(backend);
+            reference.input(message);
+            sha256.input(message);
+            std::array<uint8_t, 32> expected = reference.digest();
+            passed = passed && sha256.digest() == expected;
+
+            // 流式输入：按不同长度分段调用update()，结果应与一次性输入一致
+            SHA256 streaming(backend);
+            for (size_t pos = 0, chunk = 1; pos < length; pos += chunk, chunk = chunk * 2 + 1)
+            {
+                streaming.update(std::string_view(message).substr(pos, chunk));
+            }
+            passed = passed && streaming.digest() == expected;
+        }
+
+        std::cout << "  " << SHA256::backend_name(backend) << ": " << (passed ? "✅" : "❌") << "\n";
+        all_passed = all_passed && passed;
+    }
+    return all_passed;
+}
+
+/**
+ * @brief HMAC-SHA256与HKDF-SHA256已知答案测试
+ *
+ * 使用RFC 4231测试用例2与RFC 5869测试用例1。
+ *
+ * @return 全部通过返回true
+ */
+bool HMACKnownAnswerTest()
+{
+    HMAC_SHA256 hmac("Jefe");
+    bool hmac_passed = SHA256::toString_64(hmac.compute("what do ya want for nothing?")) ==
+                       "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843";
+
+    std::string salt, info;
+    for (int i = 0x00; i <= 0x0c; ++i)
+    {
+        salt += static_cast<char>(i);
+    }
+    for (int i = 0xf0; i <= 0xf9; ++i)
+    {
+        info += static_cast<char>(i);
+    }
+    std::vector<uint8_t> okm = HKDF_SHA256(salt, std::string(22, 0x0b)).expand(info, 42);
+    const uint8_t expected_okm[42] = {0x3c, 0xb2, 0x5f, 0x25, 0xfa, 0xac, 0xd5, 0x7a, 0x90, 0x43, 0x4f, 0x64, 0xd0, 0x36,
+                                      0x2f, 0x2a, 0x2d, 0x2d, 0x0a, 0x90, 0xcf, 0x1a, 0x5a, 0x4c, 0x5d, 0xb0, 0x2d, 0x56,
+                                      0xec, 0xc4, 0xc5, 0xbf, 0x34, 0x00, 0x72, 0x08, 0xd5, 0xb8, 0x87, 0x18, 0x58, 0x65};
+    bool hkdf_passed = std::equal(okm.begin(), okm.end(), expected_okm);
+
+    std::cout << "  HMAC-SHA256: " << (hmac_passed ? "✅" : "❌") << "\n";
+    std::cout << "  HKDF-SHA256: " << (hkdf_passed ? "✅" : "❌") << "\n";
+    return hmac_passed && hkdf_passed;
+}
+
+/**
+ * @brief 演示大文件指纹：并行Merkle树哈希与兼容的顺序SHA-256
+ *
+ * 在临时目录写入一个测试文件，分别用 SHA256Tree::hash_file 与 hash_file_sequential 计算指纹，
+ * 并与内存中的计算结果比对。
+ */
+void SHA256TreeDemo()
+{
+    std::string data(8 * SHA256Tree::DEFAULT_CHUNK_SIZE + 12345, '\0');
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>(i * 2654435761u >> 24);
+    }
+    const std::string path = "/tmp/cryptomagic_sha256_tree_demo.bin";
+    std::ofstream(path, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::array<uint8_t, 32> tree = SHA256Tree::hash_file(path);
+    auto middle = std::chrono::high_resolution_clock::now();
+    std::array<uint8_t, 32> sequential = SHA256Tree::hash_file_sequential(path);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::remove(path.c_str());
+
+    SHA256 reference;
+    reference.input(data);
+    bool consistent = sequential == reference.digest() &&
+                      tree == SHA256Tree::hash_buffer(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+
+    std::cout << "文件大小: " << data.size() << " 字节, 线程数: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "Merkle树哈希:   " << SHA256::toString_64(tree) << " ("
+              << std::chrono::duration<double, std::milli>(middle - start).count() << " ms)\n";
+    std::cout << "顺序SHA-256:    " << SHA256::toString_64(sequential) << " ("
+              << std::chrono::duration<double, std::milli>(end - middle).count() << " ms)\n";
+    std::cout << (consistent ? "✅ 文件哈希与内存计算结果一致" : "❌ 文件哈希与内存计算结果不一致") << "\n";
+}
+
 void hashdemo()
 {
     std::cout << "=== SHA256 Hash Demo ===\n";
     SHA256Demo();// SHA256测试
 
+    std::cout << "\n=== SHA256 Known Answer Test (默认后端: " << SHA256::backend_name(SHA256::detect_backend()) << ") ===\n";
+    if (!SHA256KnownAnswerTest())
+    {
+        std::cout << "错误：SHA256已知答案测试失败 ❌\n";
+    }
+
+    std::cout << "\n=== HMAC / HKDF Known Answer Test ===\n";
+    if (!HMACKnownAnswerTest())
+    {
+        std::cout << "错误：HMAC/HKDF已知答案测试失败 ❌\n";
+    }
+
+    std::cout << "\n=== SHA256 Tree Hash (大文件指纹) ===\n";
+    SHA256TreeDemo();
+
     std::cout << "\n=== Cuckoo Hash Table and Simple Hash Table Demo ===\n";
     hashTableDemo();// Cuckoo哈希表和Simple哈希表测试
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 // 引入哈希相关的头文件（根据实际文件路径调整，确保编译器能找到）
 #include "../HashTools/SHA_Family/SHA256.hpp"     // SHA256 哈希算法类
+#include "../HashTools/SHA_Family/SHA256Tree.hpp" // 基于SHA256的并行Merkle树文件哈希
+#include "../HashTools/SHA_Family/HMAC_SHA256.hpp" // HMAC-SHA256与HKDF-SHA256
 #include "../HashTools/Hash_To_Table/CuckooHash.hpp"
 #include "../HashTools/Hash_To_Table/SimpleHash.hpp"
 #include <iostream>
@@ -19,6 +21,29 @@ using namespace std;
  */
 void SHA256Demo();
 
+/**
+ * @brief SHA256 已知答案测试
+ *
+ * 对当前CPU支持的每个压缩函数后端运行标准测试向量，并与标量实现交叉比对。
+ *
+ * @return 全部通过返回true
+ */
+bool SHA256KnownAnswerTest();
+
+/**
+ * @brief HMAC-SHA256 与 HKDF-SHA256 已知答案测试
+ *
+ * @return 全部通过返回true
+ */
+bool HMACKnownAnswerTest();
+
+/**
+ * @brief SHA256 Merkle树文件哈希演示函数
+ *
+ * 对临时文件分别计算并行Merkle树哈希与兼容的顺序SHA-256，并与内存计算结果比对。
+ */
+void SHA256TreeDemo();
+
 /**
  * @brief 哈希表功能演示函数
  *
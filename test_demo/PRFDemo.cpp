@@ -8,11 +8,7 @@ void print_hex(const std::string &data, const std::string &label = "")
     {
         std::cout << label << ": ";
     }
-    for (unsigned char c : data)
-    {
-        std::cout << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(c);
-    }
-    std::cout << std::dec << std::endl;
+    std::cout << CryptoTools::HexCodec::encode(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(data.data()), data.size())) << std::endl;
 }
 
 int PRFdemo()
@@ -83,6 +79,45 @@ int PRFdemo()
         std::string long_input(1024, 'A'); // 1024字节的输入
         std::string long_output = prf.evaluate(long_input);
         print_hex(long_output, "\n长输入的输出");
+
+        // 测试宽输出模式：前缀长度一致，且扩展块与对扩展输入的evaluate结果不重合(域分离)
+        std::array<uint8_t, 64> wide_output;
+        prf.evaluate_wide(input1, wide_output);
+        print_hex(std::string(reinterpret_cast<const char *>(wide_output.data()), wide_output.size()), "\n64字节宽输出1");
+        std::string block_input(32, '\0');
+        block_input.replace(0, 16, std::string(16, 'B'));
+        block_input[31] = 1; // x || be128(1)
+        std::string wide_block = prf.evaluate_wide(block_input.substr(0, 16), 32);
+        if (prf.evaluate_wide(input1, 40) == std::string(reinterpret_cast<const char *>(wide_output.data()), 40) &&
+            wide_block.substr(16, 16) != prf.evaluate(block_input) &&
+            wide_block.substr(0, 16) != prf.evaluate(block_input.substr(0, 16)))
+        {
+            std::cout << "验证：宽输出前缀一致且与evaluate域分离 ✅" << std::endl;
+        }
+        else
+        {
+            std::cout << "错误：宽输出前缀不一致或与evaluate输出重合 ❌" << std::endl;
+        }
+
+        // 测试各后端(硬件、位切片、查表)及编译期特化版本输出一致
+        std::cout << "\n当前后端: " << PRF_AES::backend_name(prf.backend()) << std::endl;
+        PRF_AES prf_table(key, PRF_AES::Backend::Table);
+        PRF_AES prf_bitslice(key, PRF_AES::Backend::Bitslice);
+        // key为32个十六进制字符，即256位密钥，可使用编译期特化版本
+        PRF_AES256 prf_fixed(key);
+        PRF_AES::Output fixed_output = prf_fixed.evaluate(input1);
+        if (prf_table.evaluate(input1) == output1 && prf_table.evaluate(long_input) == long_output &&
+            prf_bitslice.evaluate(input1) == output1 && prf_bitslice.evaluate(long_input) == long_output &&
+            prf_table.evaluate_wide(input1, 64) == prf_bitslice.evaluate_wide(input1, 64) &&
+            prf_table.evaluate_wide(input1, 64) == std::string(reinterpret_cast<const char *>(wide_output.data()), 64) &&
+            std::string(reinterpret_cast<const char *>(fixed_output.data()), 16) == output1)
+        {
+            std::cout << "验证：各后端输出一致 ✅" << std::endl;
+        }
+        else
+        {
+            std::cout << "错误：各后端输出不一致 ❌" << std::endl;
+        }
     }
     catch (const std::exception &e)
     {
@@ -1,4 +1,5 @@
 #include "../OPRFTools/PRF_AES.h"
+#include "../OPRFTools/PRF_AES_Fixed.hpp"
 #include <iostream>
 #include <iomanip>
 #include <string>
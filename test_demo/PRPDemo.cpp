@@ -95,6 +95,100 @@ int PRPDemo()
             return 1;
         }
 
+        // 测试原地批量置换：结果与返回vector的版本一致，逆置换恢复原始数据
+        std::cout << "\n=== 测试原地批量置换 ===" << std::endl;
+        std::vector<unsigned char> buffer(CryptoTools::PRP_AES::padded_length(origin_len), 0);
+        memcpy(buffer.data(), long_data, origin_len);
+        prp.permute_data(buffer.data(), origin_len, buffer.data());
+        bool in_place_ok = buffer == encrypted_data;
+        prp.inverse_permute_data(buffer.data(), buffer.size(), buffer.data());
+        in_place_ok = in_place_ok && memcmp(buffer.data(), long_data, origin_len) == 0;
+        if (in_place_ok)
+        {
+            std::cout << "✅ 原地批量置换测试成功（后端: " << CryptoTools::PRP_AES::backend_name(prp.get_backend()) << "）" << std::endl;
+        }
+        else
+        {
+            std::cout << "❌ 原地批量置换测试失败" << std::endl;
+            return 1;
+        }
+
+        // 测试CTR模式：对double数组原地掩码后再次异或恢复
+        std::cout << "\n=== 测试CTR模式掩码 ===" << std::endl;
+        std::vector<double> values = {3.14, 2.718, 3, 0.0, 100.99, 5.555, 7, 10};
+        std::vector<double> masked(values);
+        unsigned char iv[16] = {0};
+        if (RAND_bytes(iv, sizeof(iv)) != 1)
+        {
+            throw std::runtime_error("生成随机IV失败");
+        }
+        prp.ctr_xor(iv, std::span<double>(masked));
+        print_bytes(reinterpret_cast<const unsigned char *>(masked.data()), 16, "掩码后的前两个double");
+        prp.ctr_xor_parallel(iv, std::span<double>(masked));
+        if (masked == values)
+        {
+            std::cout << "✅ CTR模式测试成功：再次异或恢复原始数组" << std::endl;
+        }
+        else
+        {
+            std::cout << "❌ CTR模式测试失败" << std::endl;
+            return 1;
+        }
+
+        // 测试任意定义域[0, N)上的置换：批量结果是[0, N)的一个排列，且与单元素接口一致
+        std::cout << "\n=== 测试小定义域置换 ===" << std::endl;
+        const uint64_t domain_size = 1000;
+        CryptoTools::SmallDomainPRP small_prp(key.data(), key_length, domain_size);
+        std::vector<uint64_t> indices(domain_size);
+        for (uint64_t i = 0; i < domain_size; ++i)
+        {
+            indices[i] = i;
+        }
+        std::vector<uint64_t> shuffled(domain_size);
+        small_prp.permute_batch(indices, shuffled);
+        std::cout << "前5个置换结果: ";
+        for (int i = 0; i < 5; ++i)
+        {
+            std::cout << indices[i] << "->" << shuffled[i] << " ";
+        }
+        std::cout << std::endl;
+
+        std::vector<bool> seen(domain_size, false);
+        bool small_ok = true;
+        for (uint64_t i = 0; i < domain_size; ++i)
+        {
+            small_ok = small_ok && shuffled[i] < domain_size && !seen[shuffled[i]] && small_prp.permute(i) == shuffled[i];
+            if (shuffled[i] < domain_size)
+            {
+                seen[shuffled[i]] = true;
+            }
+        }
+        small_prp.inverse_permute_batch(shuffled);
+        small_ok = small_ok && shuffled == indices;
+
+        // 超出定义域的输入位于第一个批次之后时，原地接口应在修改任何元素之前抛出异常
+        std::vector<uint64_t> invalid = indices;
+        invalid[300] = domain_size;
+        try
+        {
+            small_prp.permute_batch(invalid);
+            small_ok = false;
+        }
+        catch (const std::out_of_range &)
+        {
+            invalid[300] = 300;
+            small_ok = small_ok && invalid == indices;
+        }
+        if (small_ok)
+        {
+            std::cout << "✅ 小定义域置换测试成功：批量结果为[0, " << domain_size << ")的排列且可逆" << std::endl;
+        }
+        else
+        {
+            std::cout << "❌ 小定义域置换测试失败" << std::endl;
+            return 1;
+        }
+
         // 清理OpenSSL资源
         EVP_cleanup();
     }
@@ -3,6 +3,7 @@
 
 // 包含PRP_AES类的头文件（假设路径不变）
 #include "../CryptoTools/PRP_AES.hpp"
+#include "../CryptoTools/SmallDomainPRP.hpp"
 
 /**
  * @brief PRP_AES类的演示函数，测试单个块和长数据的置换/逆置换功能